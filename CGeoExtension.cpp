@@ -10,10 +10,53 @@
   *Enjoy!!
   */
 #include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <float.h>
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <iterator>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CGEO_X86_SIMD				//SIMD versions of the batch functions are compiled
+#include <immintrin.h>
+#endif
+
+#ifdef __SIZEOF_INT128__
+#define CGEO_INT128					//exact integer orientation tests use __int128
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CGEO_MMAP					//binary files are mapped into memory
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+#ifdef __cpp_lib_to_chars
+#define CGEO_CHARCONV				//numbers are read and written with from_chars and to_chars
+#endif
 
 using namespace std;
 
@@ -21,11 +64,33 @@ using namespace std;
 #include "src\Geometry\SphericalPoint.cpp"
 #include "src\Geometry\Line.cpp"
 #include "src\Geometry\Polygon.cpp"
+#include "src\Geometry\PointSet.cpp"
+#include "src\Geometry\Facet.cpp"
+#include "src\Geometry\Orientation.cpp"
 #include "src\Geometry\PlanarToSpherical.cpp"
 
 #include "src\IO\GetPoints.cpp"
 #include "src\IO\ExportToCH.cpp"
+#include "src\IO\ImportCHB.cpp"
+
+#include "src\Parallel\WorkStealingPool.cpp"
 
+#include "src\ConvexHull\HullOptions.cpp"
+#include "src\ConvexHull\RadixSort.cpp"
+#include "src\ConvexHull\AklToussaint.cpp"
 #include "src\ConvexHull\Andrew.cpp"
 #include "src\ConvexHull\GrahamScan.cpp"
 #include "src\ConvexHull\JarvisMarch.cpp"
+#include "src\ConvexHull\Chan.cpp"
+#include "src\ConvexHull\QuickHull.cpp"
+#include "src\ConvexHull\QuickHull3D.cpp"
+#include "src\ConvexHull\IncrementalHull.cpp"
+#include "src\ConvexHull\DynamicHull.cpp"
+#include "src\ConvexHull\MergeHull.cpp"
+#include "src\ConvexHull\StreamingHull.cpp"
+#include "src\ConvexHull\BatchHull.cpp"
+
+#include "src\Search\OneDSearch.cpp"
+#include "src\Search\RangeTree.cpp"
+#include "src\Search\KDTree.cpp"
+#include "src\Search\ConvexPolygon.cpp"
@@ -0,0 +1,80 @@
+/**\file: OrientationBenchmark.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Measures the throughput of the batch orientation kernels.
+  *
+  *\warning: compile it with c++11 or later version and optimizations, e.g. g++ -O2 OrientationBenchmark.cpp
+  *
+  *The same edge is tested against a few million random points.
+  *The per call test with three Points passed by value, as it was done in the hull algorithms earlier, is the baseline.
+  *It is compared with the batch functions of the Orientation class in every version supported by the processor.
+  *The scan of Jarvis' March is timed for every version as well.
+  */
+#include "..\CGeoExtension.cpp"
+#include <chrono>
+#include <random>
+
+static bool checkDirectionByValue(Point a, Point b, Point c)
+{
+	double area = a.x * b.y - b.x * a.y + b.x * c.y - c.x * b.y + c.x * a.y - a.x * c.y;
+	if(area > 0)
+		return true;
+	return false;
+}
+
+static double seconds(chrono::steady_clock::time_point start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(void)
+{
+	const int n = 1 << 22, rounds = 20;
+	const char *names[] = {"scalar", "sse2", "avx2"};
+
+	mt19937 generator(42);
+	uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+	vector<Point> points;
+	PointSet set;
+	set.reserve(n);
+	for(int iter = 0; iter < n; iter++)
+	{
+		Point p(coordinate(generator), coordinate(generator), 0.0);
+		points.push_back(p);
+		set.insertAtLast(p);
+	}
+	Point a(-1.0, -3.0, 0.0), b(2.0, 5.0, 0.0);
+	PointSetView view = set.getView();
+	vector<int> selected(n);
+	long long count = 0;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for(int round = 0; round < rounds; round++)
+		for(int iter = 0; iter < n; iter++)
+			count += checkDirectionByValue(a, b, points[iter]);
+	double baseline = seconds(start);
+	printf("%-8s %8.1f Mpoints/s\n", "by value", (double)n * rounds / baseline / 1e6);
+
+	for(int kernel = Orientation::SCALAR; kernel <= Orientation::AVX2; kernel++)
+	{
+		if(!Orientation::setKernel((Orientation::Kernel)kernel))
+			continue;
+		start = chrono::steady_clock::now();
+		for(int round = 0; round < rounds; round++)
+			count += Orientation::selectLeft(a.x, a.y, b.x, b.y, view.x, view.y, NULL, n, selected.data());
+		double time = seconds(start);
+		printf("%-8s %8.1f Mpoints/s  %.2fx\n", names[kernel], (double)n * rounds / time / 1e6, baseline / time);
+	}
+
+	printf("\nJarvis' March on %d points\n", n);
+	for(int kernel = Orientation::SCALAR; kernel <= Orientation::AVX2; kernel++)
+	{
+		if(!Orientation::setKernel((Orientation::Kernel)kernel))
+			continue;
+		start = chrono::steady_clock::now();
+		count += JarvisMarch::convexHullJarvisIndices(view).size();
+		printf("%-8s %8.3f s\n", names[kernel], seconds(start));
+	}
+	return count == 0;
+}
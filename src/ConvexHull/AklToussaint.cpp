@@ -0,0 +1,170 @@
+/**\file: AklToussaint.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Akl-Toussaint heuristic to drop the points which can not be on the convex hull.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The extreme points along the x axis, the y axis and the two diagonals are found in one pass.
+  *They are on the convex hull, so the octagon formed by them is inside the convex hull.
+  *Any point strictly inside this octagon can not be on the convex hull and is dropped in a second pass.
+  *Points on the boundary of the octagon are kept, so the collinear points on the hull are not lost.
+  *For uniformly distributed points most of the points are dropped and the hull algorithm has to sort only the rest.
+  *Both passes take O(n) time, the second one uses the batch functions of the Orientation class.
+  *Points on an integer grid are tested exactly with integer arithmetic instead.
+  */
+class AklToussaint
+{
+/**
+  *\fn static vector<int> filter(PointSetView points)
+  *\param PointSetView points
+  *\return the indices of the points which are kept
+  *
+  *\brief A function to drop the points strictly inside the octagon of the extreme points.
+  *
+  *The indices refer to the positions in the view and are in increasing order.
+  *If the extreme points do not form a polygon, e.g. when all the points are collinear, all the indices are returned.
+  *
+  */
+public:
+	static vector<int> filter(PointSetView points)
+	{
+		/**
+		  *\var double px[8], py[8] (local)
+		  *\brief The vertices of the octagon, repeated extreme points are removed.
+		  */
+		int iter, n = points.size;
+		vector<int> result(n);
+		double px[8], py[8];
+		int m = octagon(points, px, py);
+
+		if(m < 3)							//no polygon, keep everything
+		{
+			for(iter = 0; iter < n; iter++)
+				result[iter] = iter;
+			return result;
+		}
+
+		result.resize(Orientation::selectOutside(px, py, m, points.x, points.y, NULL, n, result.data()));
+		return result;
+	}
+
+/**
+  *\fn static vector<int> filter(BasicPointSetView<int> points)
+  *\param BasicPointSetView<int> points
+  *\return the indices of the points which are kept
+  *
+  *\brief The same filter for points on an integer grid.
+  *
+  *A point is tested against the edges of the octagon one after the other, until it is outside of one of them.
+  *If the octagon is less than 2^31 wide and high, the test is exact with 64 bit integers, otherwise the integer turn is used.
+  *
+  */
+public:
+	static vector<int> filter(BasicPointSetView<int> points)
+	{
+		/**
+		  *\var int64_t ex[8], ey[8] (local)
+		  *\brief The edges of the octagon, from each vertex to the next one.
+		  */
+		int iter, edge, n = points.size;
+		vector<int> result;
+		const int *x = points.x, *y = points.y;
+		int px[8], py[8];
+		int m = octagon(points, px, py);
+
+		if(m < 3)							//no polygon, keep everything
+		{
+			result.resize(n);
+			for(iter = 0; iter < n; iter++)
+				result[iter] = iter;
+			return result;
+		}
+
+		int64_t ex[8], ey[8];
+		int xmin = px[0], xmax = px[0], ymin = py[0], ymax = py[0];
+		for(edge = 0; edge < m; edge++)
+		{
+			ex[edge] = (int64_t)px[(edge + 1) % m] - px[edge];
+			ey[edge] = (int64_t)py[(edge + 1) % m] - py[edge];
+			xmin = min(xmin, px[edge]);
+			xmax = max(xmax, px[edge]);
+			ymin = min(ymin, py[edge]);
+			ymax = max(ymax, py[edge]);
+		}
+		bool small = (int64_t)xmax - xmin < ((int64_t)1 << 31) && (int64_t)ymax - ymin < ((int64_t)1 << 31);
+
+		for(iter = 0; iter < n; iter++)
+		{
+			for(edge = 0; edge < m; edge++)
+			{
+				int64_t dx = (int64_t)x[iter] - px[edge], dy = (int64_t)y[iter] - py[edge];
+				if(small ? ex[edge] * dy - ey[edge] * dx <= 0 : Orientation::turn(px[edge], py[edge], px[(edge + 1) % m], py[(edge + 1) % m], x[iter], y[iter]) <= 0)
+					break;
+			}
+			if(edge < m)					//not strictly inside
+				result.push_back(iter);
+		}
+		return result;
+	}
+
+/**
+  *\fn template<class T> static int octagon(BasicPointSetView<T> points, T *px, T *py)
+  *\param BasicPointSetView<T> points
+  *\param T *px, *py arrays of 8 to store the vertices of the octagon
+  *\return the number of vertices of the octagon
+  *
+  *\brief Find the extreme points in one pass and store them in anti-clockwise order, without the repeated ones.
+  *
+  *The diagonals are compared in double, which is exact for int co-ordinates as well.
+  */
+private:
+	template<class T>
+	static int octagon(BasicPointSetView<T> points, T *px, T *py)
+	{
+		/**
+		  *\var int extreme[8] (local)
+		  *\brief The indices of the extreme points in anti-clockwise order, starting from the bottom.
+		  */
+		int iter, n = points.size;
+		const T *x = points.x, *y = points.y;
+
+		int extreme[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		for(iter = 1; iter < n; iter++)
+		{
+			double sum = (double)x[iter] + y[iter], difference = (double)x[iter] - y[iter];
+			if(y[iter] < y[extreme[0]])								//bottom
+				extreme[0] = iter;
+			if(difference > (double)x[extreme[1]] - y[extreme[1]])	//bottom right
+				extreme[1] = iter;
+			if(x[iter] > x[extreme[2]])								//right
+				extreme[2] = iter;
+			if(sum > (double)x[extreme[3]] + y[extreme[3]])			//top right
+				extreme[3] = iter;
+			if(y[iter] > y[extreme[4]])								//top
+				extreme[4] = iter;
+			if(-difference > (double)y[extreme[5]] - x[extreme[5]])	//top left
+				extreme[5] = iter;
+			if(x[iter] < x[extreme[6]])								//left
+				extreme[6] = iter;
+			if(sum < (double)x[extreme[7]] + y[extreme[7]])			//bottom left
+				extreme[7] = iter;
+		}
+
+		int m = 0;
+		for(iter = 0; iter < 8 && n > 0; iter++)
+		{
+			int i = extreme[iter];
+			if(m > 0 && x[i] == px[m - 1] && y[i] == py[m - 1])
+				continue;
+			px[m] = x[i];
+			py[m] = y[i];
+			m++;
+		}
+		while(m > 1 && px[m - 1] == px[0] && py[m - 1] == py[0])
+			m--;
+		return m;
+	}
+};
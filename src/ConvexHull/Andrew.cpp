@@ -14,6 +14,7 @@
   *The time complexity of the algorithm is O(nlogn).
   *It might increase to O(n^2) if c++98 compiler is used.
   *For indepth description, plese see the individual function description.
+  *Points on an integer grid can be passed as a BasicPointSetView<int>, their hull is computed with exact integer arithmetic.
   *
   */
 class Andrew
@@ -62,6 +63,189 @@ public:
 		ExportToCH::write(p.second, p.first, filepath);
 	}
 
+/**
+  *\fn static Polygon convexHullAndrew(vector<Point> points, HullOptions options)
+  *\param vector<Point> points
+  *\param HullOptions options
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull with Andrew's Algorithm and the optional stages in options
+  *
+  *With options.prefilter the points which can not be on the hull are dropped before sorting.
+  *The polygon is the same as the one returned without any options.
+  *
+  */
+public:
+	static Polygon convexHullAndrew(vector<Point> points, HullOptions options)
+	{
+		pair<vector<int>, vector<Point>> p = AndrewAlgo(points, options);
+		Polygon result;									//create a polygon
+		for(int i : p.first)
+			result.insertAtLast(p.second[i]);			//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullAndrewToCH(vector<Point> points, string filepath, HullOptions options)
+  *\param vector<Point> points
+  *\param string filepath
+  *\param HullOptions options
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull with the optional stages in options
+  *
+  *The points are sorted by x and then y, and they are written in that sorted order with the indices referring to it,
+  *the same as without any options. With options.prefilter the points which can not be on the hull are still written.
+  *
+  */
+public:
+	static void convexHullAndrewToCH(vector<Point> points, string filepath, HullOptions options)
+	{
+		pair<vector<int>, vector<Point>> p = AndrewAlgo(points, options);
+		ExportToCH::write(p.second, p.first, filepath);
+	}
+
+/**
+  *\fn static Polygon convexHullAndrewParallel(vector<Point> points, int threads)
+  *\param vector<Point> points
+  *\param int threads
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A multi-threaded version of convexHullAndrew
+  *
+  *The sorted points are split into one slab per thread.
+  *Each thread builds the upper and lower chains of its own slab and the neighbouring chains are merged afterwards.
+  *If threads is zero or less, the number of hardware threads is used.
+  *Small inputs fall back to the single threaded algorithm.
+  *The result is the same as that of convexHullAndrew.
+  *
+  */
+public:
+	static Polygon convexHullAndrewParallel(vector<Point> points, int threads = 0)
+	{
+		pair<vector<int>, vector<Point>> p = AndrewParallelAlgo(points, threads);
+		Polygon result;									//create a polygon
+		for(int i : p.first)
+			result.insertAtLast(p.second[i]);			//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullAndrewParallelToCH(vector<Point> points, string filepath, int threads)
+  *\param vector<Point> points
+  *\param string filepath
+  *\param int threads
+  *\return void
+  *
+  *\brief A multi-threaded version of convexHullAndrewToCH
+  *
+  *The convex hull is calculated with convexHullAndrewParallel and saved as .ch file at the given filepath.
+  *
+  */
+public:
+	static void convexHullAndrewParallelToCH(vector<Point> points, string filepath, int threads = 0)
+	{
+		pair<vector<int>, vector<Point>> p = AndrewParallelAlgo(points, threads);
+		ExportToCH::write(p.second, p.first, filepath);
+	}
+
+/**
+  *\fn static Polygon convexHullAndrew(PointSetView points, HullOptions options)
+  *\param PointSetView points
+  *\param HullOptions options
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of a PointSet with Andrew's Algorithm
+  *
+  *The points are not copied, only an array of indices is sorted.
+  *The z co-ordinates are never read.
+  *The polygon is the same as the one returned for a vector of the same points.
+  *
+  */
+public:
+	static Polygon convexHullAndrew(PointSetView points, HullOptions options = HullOptions())
+	{
+		vector<int> ch = AndrewAlgo(points, options);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullAndrewToCH(PointSetView points, string filepath, HullOptions options)
+  *\param PointSetView points
+  *\param string filepath
+  *\param HullOptions options
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull of a PointSet
+  *
+  *The points are written in the order they are stored in the set, they are not sorted.
+  *
+  */
+public:
+	static void convexHullAndrewToCH(PointSetView points, string filepath, HullOptions options = HullOptions())
+	{
+		ExportToCH::write(points, AndrewAlgo(points, options), filepath);
+	}
+
+/**
+  *\fn static vector<int> convexHullAndrewIndices(PointSetView points, HullOptions options)
+  *\param PointSetView points
+  *\param HullOptions options
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a PointSet
+  *
+  *The indices refer to the positions of the points in the set.
+  *The order is the same as that of the polygon returned by convexHullAndrew.
+  *
+  */
+public:
+	static vector<int> convexHullAndrewIndices(PointSetView points, HullOptions options = HullOptions())
+	{
+		return AndrewAlgo(points, options);
+	}
+
+/**
+  *\fn static Polygon convexHullAndrew(BasicPointSetView<int> points, HullOptions options)
+  *\param BasicPointSetView<int> points
+  *\param HullOptions options
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of points on an integer grid with Andrew's Algorithm
+  *
+  *The side of a point is tested with 64 and 128 bit integers, which is exact without any floating point filter.
+  *With options.radixSort, both co-ordinates are sorted in a single integer radix sort.
+  *The co-ordinates of the polygon are converted to double.
+  *
+  */
+public:
+	static Polygon convexHullAndrew(BasicPointSetView<int> points, HullOptions options = HullOptions())
+	{
+		vector<int> ch = AndrewAlgo(points, options);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(Point(points.getPoint(i)));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static vector<int> convexHullAndrewIndices(BasicPointSetView<int> points, HullOptions options)
+  *\param BasicPointSetView<int> points
+  *\param HullOptions options
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a set of points on an integer grid
+  *
+  */
+public:
+	static vector<int> convexHullAndrewIndices(BasicPointSetView<int> points, HullOptions options = HullOptions())
+	{
+		return AndrewAlgo(points, options);
+	}
+
 /**
   *\fn static pair<vector <int>, vector <Point>> AndrewAlgo(vector<Point> points)
   *\param vector<Point> points
@@ -76,6 +260,7 @@ public:
   *This function returns a pair with a integer vector and a Point class vector.
   *The Point class vector is the set of points whose CH is calculated.
   *The integer vector contains the index of all the points in Point class vectors who are present in covex hull.
+  *Of the copies of a point only one is in the convex hull, so the hull does not depend on the points inside it.
   */
 private:
 	static pair<vector <int>, vector <Point>> AndrewAlgo(vector<Point> points)
@@ -92,7 +277,7 @@ private:
 		  *
 		  */
 		int iter, temp;
-		static vector<int> result;
+		vector<int> result;
 
 		//if points are less than or equal to three, include all in convex hull.
 		if(points.size() <= 3)
@@ -102,15 +287,15 @@ private:
 			return {result, points};
 		}
 
-		sort(points.begin(), points.end(), [](Point const& A, Point const& B) {
-			return (A.x < B.x)? true:(A.x > B.x)? false:(A.y < B.y)? true:false;
-		});
+		sort(points.begin(), points.end(), compareXY);
 		
 		vector<Point> upper;
 		for(iter = 0; iter < points.size(); iter++)
 		{
 			temp = upper.size();
-			while(temp > 1 && checkDirection(upper[temp - 2], upper[temp - 1], points[iter]))
+			if(temp > 0 && upper[temp - 1].x == points[iter].x && upper[temp - 1].y == points[iter].y)
+				continue;							//a copy of the last point, it would stop the chain from turning
+			while(temp > 1 && Orientation::checkDirection(upper[temp - 2], upper[temp - 1], points[iter]))
 			{
 				upper.pop_back();
 				result.pop_back();
@@ -125,7 +310,9 @@ private:
 		for(iter = points.size() - 1; iter >= 0; iter--)
 		{
 			temp = lower.size();
-			while(temp > 1 && checkDirection(lower[temp - 2], lower[temp - 1], points[iter]))
+			if(temp > 0 && lower[temp - 1].x == points[iter].x && lower[temp - 1].y == points[iter].y)
+				continue;
+			while(temp > 1 && Orientation::checkDirection(lower[temp - 2], lower[temp - 1], points[iter]))
 			{
 				lower.pop_back();
 				result.pop_back();
@@ -135,28 +322,356 @@ private:
 			result.push_back(iter);
 		}
 		result.pop_back();
+		if(result.empty())							//all the points are copies of one point
+			result.push_back(0);
+		return {result, points};
+	}
+
+/**
+  *\fn static pair<vector <int>, vector <Point>> AndrewAlgo(vector<Point> points, HullOptions options)
+  *\param vector<Point> points
+  *\param HullOptions options
+  *\return pair<vector <int>, vector <Point>>
+  *
+  *\brief a private function to get convex hull with the optional stages in options
+  *
+  *Without any option it is the same as AndrewAlgo(points).
+  *Otherwise the points are sorted the same way, with RadixSort::sortXY if options.radixSort, and only the chains are built on a PointSet.
+  *With options.prefilter, AklToussaint::filter runs on the sorted points and the chains are built on the points it keeps.
+  *So the returned points and indices are the same as those of AndrewAlgo(points), and so is the .ch file written from them.
+  *Only points with the same x and y but different z may be in another order with the radix sort, which is stable.
+  */
+private:
+	static pair<vector <int>, vector <Point>> AndrewAlgo(vector<Point> points, HullOptions options)
+	{
+		int iter, n = points.size();
+		if(n <= 3 || (!options.prefilter && !options.radixSort))
+			return AndrewAlgo(points);
+
+		if(options.radixSort)
+		{
+			vector<int> order(n);
+			for(iter = 0; iter < n; iter++)
+				order[iter] = iter;
+			RadixSort::sortXY(PointSet(points), order, options.sortThreads);
+			vector<Point> sorted;
+			sorted.reserve(n);
+			for(int i : order)
+				sorted.push_back(points[i]);
+			points.swap(sorted);
+		}
+		else
+			sort(points.begin(), points.end(), compareXY);		//the same order as AndrewAlgo(points)
+
+		PointSet set(points);
+		vector<int> order;
+		if(options.prefilter)
+			order = AklToussaint::filter(set.getView());		//in increasing order, so still sorted
+		else
+		{
+			order.resize(n);
+			for(iter = 0; iter < n; iter++)
+				order[iter] = iter;
+		}
+		return {chains(set.getView(), order), points};
+	}
+
+/**
+  *\fn template<class T> static vector<int> AndrewAlgo(BasicPointSetView<T> points, HullOptions options)
+  *\param BasicPointSetView<T> points
+  *\param HullOptions options
+  *\return vector<int>
+  *
+  *\brief a private function to get convex hull of a PointSetView or a BasicPointSetView<int>
+  *
+  *It is the same algorithm as above but an array of indices is sorted instead of the points.
+  *With options.prefilter, the indices of the points dropped by AklToussaint::filter are not sorted at all.
+  *With options.radixSort, the indices are sorted by RadixSort::sortXY.
+  *The overloads of AklToussaint::filter, RadixSort::sortXY and Orientation::checkDirection for the type of the co-ordinates are used.
+  *The returned indices refer to the positions in the view.
+  */
+private:
+	template<class T>
+	static vector<int> AndrewAlgo(BasicPointSetView<T> points, HullOptions options)
+	{
+		/**
+		  *\var vector<int> order (local)
+		  *\brief The indices of the points sorted by x and then by y.
+		  *
+		  *\var vector<int> result (local)
+		  *\brief The vector to store the resultant convex hull indices
+		  *
+		  */
+		int iter;
+		int n = points.size;
+		vector<int> result;
+
+		//if points are less than or equal to three, include all in convex hull.
+		if(n <= 3)
+		{
+			for(iter = 0; iter < n; iter++)
+				result.push_back(iter);
+			return result;
+		}
+
+		const T *x = points.x, *y = points.y;
+		vector<int> order;
+		if(options.prefilter)
+			order = AklToussaint::filter(points);
+		else
+		{
+			order.resize(n);
+			for(iter = 0; iter < n; iter++)
+				order[iter] = iter;
+		}
+		if(options.radixSort)
+			RadixSort::sortXY(points, order, options.sortThreads);
+		else
+			sort(order.begin(), order.end(), [x, y](int A, int B) {
+				return (x[A] < x[B])? true:(x[A] > x[B])? false:(y[A] < y[B])? true:false;
+			});
+		return chains(points, order);
+	}
+
+/**
+  *\fn template<class T> static vector<int> chains(BasicPointSetView<T> points, const vector<int> &order)
+  *\param BasicPointSetView<T> points
+  *\param const vector<int> &order the indices of the points to build the chains on, sorted by x and then by y
+  *\return the indices of the points on the upper chain and then on the lower chain
+  *
+  *\brief The upper and the lower chain of Andrew's Algorithm on sorted indices.
+  */
+private:
+	template<class T>
+	static vector<int> chains(BasicPointSetView<T> points, const vector<int> &order)
+	{
+		int iter, temp, start;
+		int n = order.size();
+		vector<int> result;
+		result.reserve(n);
+		for(iter = 0; iter < n; iter++)					//upper hull
+		{
+			temp = result.size();
+			if(temp > 0 && samePoint(points, result[temp - 1], order[iter]))
+				continue;
+			while(temp > 1 && Orientation::checkDirection(points, result[temp - 2], result[temp - 1], order[iter]))
+			{
+				result.pop_back();
+				temp--;
+			}
+			result.push_back(order[iter]);
+		}
+		result.pop_back();
+
+		start = result.size();
+		for(iter = n - 1; iter >= 0; iter--)			//lower hull
+		{
+			temp = result.size();
+			if(temp > start && samePoint(points, result[temp - 1], order[iter]))
+				continue;
+			while(temp - start > 1 && Orientation::checkDirection(points, result[temp - 2], result[temp - 1], order[iter]))
+			{
+				result.pop_back();
+				temp--;
+			}
+			result.push_back(order[iter]);
+		}
+		result.pop_back();
+		if(result.empty() && n > 0)
+			result.push_back(order[0]);
+		return result;
+	}
+
+/**
+  *\fn template<class T> static bool samePoint(BasicPointSetView<T> points, int first, int second)
+  *\param BasicPointSetView<T> points
+  *\param int first, second indices of two points
+  *\return true if both points have the same x and y
+  */
+private:
+	template<class T>
+	static bool samePoint(BasicPointSetView<T> points, int first, int second)
+	{
+		return points.x[first] == points.x[second] && points.y[first] == points.y[second];
+	}
+
+/**
+  *\fn static pair<vector <int>, vector <Point>> AndrewParallelAlgo(vector<Point> points, int threads)
+  *\param vector<Point> points
+  *\param int threads
+  *\return pair<vector <int>, vector <Point>>
+  *
+  *\brief a private function to get convex hull with multiple threads
+  *
+  *It returns the same pair as AndrewAlgo, i.e. the sorted points and the indices of the hull points in it.
+  *The points are sorted in parallel and split into one slab of consecutive points per thread.
+  *Every thread builds the upper and the lower chain of its slab.
+  *The chains of neighbouring slabs are then merged from left to right (upper) and right to left (lower).
+  *Points dropped from a slab chain can never be on the hull of all the points, so the merge only looks at the chains.
+  */
+private:
+	static pair<vector <int>, vector <Point>> AndrewParallelAlgo(vector<Point> points, int threads)
+	{
+		/**
+		  *\var vector<vector<int>> upper (local)
+		  *\brief The upper chain of every slab.
+		  *
+		  *\var vector<vector<int>> lower (local)
+		  *\brief The lower chain of every slab.
+		  *
+		  *\var vector<int> result (local)
+		  *\brief The vector to store the resultant convex hull indices
+		  *
+		  */
+		int iter;
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads > (int)(points.size() / MIN_SLAB))
+			threads = points.size() / MIN_SLAB;
+		if(threads <= 1)						//not worth splitting, use the single threaded version
+			return AndrewAlgo(points);
+
+		parallelSort(points, threads);
+
+		int n = points.size();
+		vector<vector<int>> upper(threads), lower(threads);
+		vector<thread> workers;
+		for(iter = 0; iter < threads; iter++)
+		{
+			workers.push_back(thread([&points, &upper, &lower, iter, threads, n]() {
+				int begin = (long long)n * iter / threads;
+				int end = (long long)n * (iter + 1) / threads;
+				for(int i = begin; i < end; i++)			//upper chain from left to right
+					pushToChain(points, upper[iter], i);
+				for(int i = end - 1; i >= begin; i--)		//lower chain from right to left
+					pushToChain(points, lower[iter], i);
+			}));
+		}
+		for(thread &t : workers)
+			t.join();
+
+		//merge the neighbouring chains, the lower chains run from right to left
+		vector<int> result = upper[0];
+		for(iter = 1; iter < threads; iter++)
+			mergeChain(points, result, upper[iter]);
+		result.pop_back();
+
+		vector<int> lowerhull = lower[threads - 1];
+		for(iter = threads - 2; iter >= 0; iter--)
+			mergeChain(points, lowerhull, lower[iter]);
+		lowerhull.pop_back();
+
+		result.insert(result.end(), lowerhull.begin(), lowerhull.end());
+		if(result.empty())						//all the points are copies of one point
+			result.push_back(0);
 		return {result, points};
 	}
 
 /**
-  *\fn static bool checkDirection(Point a, Point b, Point c)
-  *\param Point a
-  *\param Point b
-  *\param Point c
-  *\return a boolean stating the sign of area
+  *\var static const int MIN_SLAB
+  *\brief The least number of points given to a thread by AndrewParallelAlgo.
+  */
+private:
+	static const int MIN_SLAB = 1 << 15;
+
+/**
+  *\fn static void pushToChain(vector<Point> &points, vector<int> &chain, int index)
+  *\param vector<Point> &points
+  *\param vector<int> &chain
+  *\param int index
+  *
+  *\brief A single step of the chain building loop in AndrewAlgo
   *
-  *\brief returns true if area is greater else false
+  *A copy of the last point of the chain is not added.
+  *Otherwise the points at the end of the chain which are not turning right anymore are removed.
+  *Then the index is added at the end of the chain.
+  */
+private:
+	static void pushToChain(vector<Point> &points, vector<int> &chain, int index)
+	{
+		int temp = chain.size();
+		if(temp > 0 && points[chain[temp - 1]].x == points[index].x && points[chain[temp - 1]].y == points[index].y)
+			return;
+		while(temp > 1 && Orientation::checkDirection(points[chain[temp - 2]], points[chain[temp - 1]], points[index]))
+		{
+			chain.pop_back();
+			temp--;
+		}
+		chain.push_back(index);
+	}
+
+/**
+  *\fn static void mergeChain(vector<Point> &points, vector<int> &chain, vector<int> &next)
+  *\param vector<Point> &points
+  *\param vector<int> &chain
+  *\param vector<int> &next
+  *
+  *\brief Merge the chain of the neighbouring slab into chain
+  *
+  *Every index of next is added with pushToChain, in its order.
+  *The first ones remove the end of chain back to the common tangent of both chains.
+  *Once the tangent is reached no more points are removed, as the rest of next is already convex.
+  *Every point is added and removed at most once, so it takes O(size of both chains) time.
+  */
+private:
+	static void mergeChain(vector<Point> &points, vector<int> &chain, vector<int> &next)
+	{
+		for(int i : next)
+			pushToChain(points, chain, i);
+	}
+
+/**
+  *\fn static void parallelSort(vector<Point> &points, int threads)
+  *\param vector<Point> &points
+  *\param int threads
+  *
+  *\brief Sort the points the same way as AndrewAlgo with multiple threads
+  *
+  *Every thread sorts a part of the points.
+  *The sorted parts are then merged in pairs till a single part is left.
+  */
+private:
+	static void parallelSort(vector<Point> &points, int threads)
+	{
+		int n = points.size();
+		vector<int> bounds;
+		for(int iter = 0; iter <= threads; iter++)
+			bounds.push_back((long long)n * iter / threads);
+
+		vector<thread> workers;
+		for(int iter = 0; iter < threads; iter++)
+			workers.push_back(thread([&points, &bounds, iter]() {
+				sort(points.begin() + bounds[iter], points.begin() + bounds[iter + 1], compareXY);
+			}));
+		for(thread &t : workers)
+			t.join();
+
+		for(int width = 1; width < threads; width *= 2)		//merge the neighbouring parts
+		{
+			workers.clear();
+			for(int iter = 0; iter + width < threads; iter += 2 * width)
+			{
+				int first = bounds[iter], middle = bounds[iter + width], last = bounds[min(iter + 2 * width, threads)];
+				workers.push_back(thread([&points, first, middle, last]() {
+					inplace_merge(points.begin() + first, points.begin() + middle, points.begin() + last, compareXY);
+				}));
+			}
+			for(thread &t : workers)
+				t.join();
+		}
+	}
+
+/**
+  *\fn static bool compareXY(Point const& A, Point const& B)
+  *\param Point const& A
+  *\param Point const& B
+  *\return true if A comes before B
   *
-  *The function calculates the signed area of all the three points.
-  *Returns true if the area is positive.
-  *Else false.
+  *\brief The order in which the points are sorted, by x and then by y.
   */
 private:
-	static bool checkDirection(Point a, Point b, Point c)
+	static bool compareXY(Point const& A, Point const& B)
 	{
-		double area = a.x * b.y - b.x * a.y + b.x * c.y - c.x * b.y + c.x * a.y - a.x * c.y;
-		if(area > 0)
-			return true;
-		return false;
+		return (A.x < B.x)? true:(A.x > B.x)? false:(A.y < B.y)? true:false;
 	}
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**\file: BatchHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Get the convex hulls of many small sets of points at once.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The sets, called clusters, are stored one after the other in a single PointSetView,
+  *and an array of offsets tells where every cluster starts, like the rows of a sparse matrix.
+  *The hulls are returned the same way, as one array of indices and an array of offsets.
+  *Consecutive clusters are grouped into tasks of a WorkStealingPool with enough points to be worth a task.
+  *Every task allocates its buffers once for its largest cluster, so there is no allocation for a single cluster.
+  *The hull of every cluster is found with the monotone chain of Andrew's Algorithm, in O(mlogm) time for m points.
+  */
+class BatchHull
+{
+/**
+  *\fn static void convexHullBatch(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, int threads)
+  *\param PointSetView points all the clusters one after the other
+  *\param const vector<int> &offsets cluster c is made of the points offsets[c] to offsets[c + 1] - 1
+  *\param vector<int> &hull the indices of the hulls of all the clusters, one after the other
+  *\param vector<int> &hullOffsets the hull of cluster c is hull[hullOffsets[c]] to hull[hullOffsets[c + 1] - 1]
+  *\param int threads
+  *
+  *\brief A function to get the convex hulls of all the clusters.
+  *
+  *offsets has one entry more than the number of clusters, its first entry is 0 and its last entry is the number of points.
+  *The indices in hull refer to the positions in points, so the hull of a cluster can be exported with points directly.
+  *Every hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners are kept, and an empty cluster has an empty hull.
+  *threads is the number of threads of the pool, zero or less means the number of hardware threads and one means no pool.
+  *hull and hullOffsets are resized, their memory is reused if they are passed again.
+  *
+  */
+public:
+	static void convexHullBatch(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, int threads = 0)
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || points.size < 2 * MIN_TASK)
+		{
+			BatchAlgo(points, offsets, hull, hullOffsets, NULL);
+			return;
+		}
+		WorkStealingPool pool(threads);
+		BatchAlgo(points, offsets, hull, hullOffsets, &pool);
+	}
+
+/**
+  *\fn static void convexHullBatch(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, WorkStealingPool &pool)
+  *\param WorkStealingPool &pool a pool to reuse for many batches
+  *
+  *\brief The same as the function above, on the threads of the given pool.
+  *
+  */
+public:
+	static void convexHullBatch(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, WorkStealingPool &pool)
+	{
+		BatchAlgo(points, offsets, hull, hullOffsets, &pool);
+	}
+
+/**
+  *\fn static void BatchAlgo(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, WorkStealingPool *pool)
+  *\param WorkStealingPool *pool NULL to run everything on the calling thread
+  *
+  *\brief A private function with the implementation of the batch.
+  *
+  *A hull has at most as many points as its cluster, so every hull is first written at the offset of its cluster
+  *and its size is kept in hullOffsets. Then the hulls are moved to the front one after the other.
+  *
+  */
+private:
+	static void BatchAlgo(PointSetView points, const vector<int> &offsets, vector<int> &hull, vector<int> &hullOffsets, WorkStealingPool *pool)
+	{
+		int clusters = offsets.size() - 1;
+		hull.resize(points.size);
+		hullOffsets.assign(clusters + 1, 0);
+		if(clusters <= 0)
+		{
+			hull.clear();
+			hullOffsets.assign(1, 0);
+			return;
+		}
+
+		vector<int> tasks;						//the first cluster of every task
+		for(int c = 0; c < clusters; c++)
+			if(tasks.empty() || offsets[c] - offsets[tasks.back()] >= MIN_TASK)
+				tasks.push_back(c);
+		tasks.push_back(clusters);
+
+		auto task = [&](int first, int last) {
+			int largest = 0;
+			for(int c = first; c < last; c++)
+				largest = max(largest, offsets[c + 1] - offsets[c]);
+			vector<Entry> sorted(largest);
+			vector<int> chain(2 * largest);
+			for(int c = first; c < last; c++)
+				hullOffsets[c + 1] = clusterHull(points, offsets[c], offsets[c + 1], sorted.data(), chain.data(), hull.data() + offsets[c]);
+		};
+		if(pool && tasks.size() > 2)
+		{
+			WorkStealingPool::Group group;
+			for(int t = 0; t + 1 < (int)tasks.size(); t++)
+			{
+				int first = tasks[t], last = tasks[t + 1];
+				pool->run(group, [&task, first, last]() { task(first, last); });
+			}
+			pool->wait(group);
+		}
+		else
+			task(0, clusters);
+
+		for(int c = 0; c < clusters; c++)		//move the hulls to the front
+		{
+			int size = hullOffsets[c + 1];
+			hullOffsets[c + 1] = hullOffsets[c] + size;
+			if(hullOffsets[c] != offsets[c])
+				copy(hull.begin() + offsets[c], hull.begin() + offsets[c] + size, hull.begin() + hullOffsets[c]);
+		}
+		hull.resize(hullOffsets[clusters]);
+	}
+
+/**
+  *\var struct Entry
+  *\brief A point of a cluster with its index, copied so that the sort works on contiguous memory.
+  */
+private:
+	struct Entry
+	{
+		double x, y;
+		int index;
+	};
+
+/**
+  *\fn static int clusterHull(PointSetView &points, int begin, int end, Entry *sorted, int *chain, int *out)
+  *\param PointSetView &points
+  *\param int begin, end the points of the cluster
+  *\param Entry *sorted a buffer for the points of the cluster
+  *\param int *chain a buffer for twice the points of the cluster
+  *\param int *out where the indices of the hull are written
+  *\return the number of corners of the hull
+  *
+  *\brief The monotone chain on one cluster, the upper chain from left to right and then the lower chain back.
+  *
+  *A point is removed from the chain unless it makes a clockwise turn, so points in the middle of an edge and repeated points are dropped.
+  *
+  */
+private:
+	static int clusterHull(PointSetView &points, int begin, int end, Entry *sorted, int *chain, int *out)
+	{
+		int n = end - begin;
+		if(n == 0)
+			return 0;
+		for(int iter = 0; iter < n; iter++)
+		{
+			sorted[iter].x = points.x[begin + iter];
+			sorted[iter].y = points.y[begin + iter];
+			sorted[iter].index = iter;
+		}
+		sort(sorted, sorted + n, [](const Entry &a, const Entry &b) {
+			return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.index < b.index)));
+		});
+		if(sorted[0].x == sorted[n - 1].x && sorted[0].y == sorted[n - 1].y)
+		{
+			out[0] = begin + sorted[0].index;	//all the points are the same
+			return 1;
+		}
+
+		int k = 0;
+		for(int iter = 0; iter < n; iter++)		//upper chain
+		{
+			while(k >= 2 && turn(sorted[chain[k - 2]], sorted[chain[k - 1]], sorted[iter]) >= 0)
+				k--;
+			chain[k++] = iter;
+		}
+		for(int iter = n - 2, upper = k + 1; iter >= 0; iter--)	//lower chain
+		{
+			while(k >= upper && turn(sorted[chain[k - 2]], sorted[chain[k - 1]], sorted[iter]) >= 0)
+				k--;
+			chain[k++] = iter;
+		}
+		k--;									//the least point is at both ends
+		for(int iter = 0; iter < k; iter++)
+			out[iter] = begin + sorted[chain[iter]].index;
+		return k;
+	}
+
+/**
+  *\var static const int MIN_TASK
+  *\brief The least number of points in a task of the pool.
+  */
+private:
+	static const int MIN_TASK = 1 << 14;
+
+/**
+  *\fn static double turn(const Entry &a, const Entry &b, const Entry &c)
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  *
+  *\brief Orientation::turn like the one of Chan's Algorithm.
+  */
+private:
+	static double turn(const Entry &a, const Entry &b, const Entry &c)
+	{
+		return Orientation::turn(a.x, a.y, b.x, b.y, c.x, c.y);
+	}
+};
@@ -0,0 +1,447 @@
+/**\file: Chan.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Get convex hull of a given set of points with Chan's Algorithm
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The class provides a static function to get a convex hull of given set of points.
+  *Chan's Algorithm is used to find the convex hull.
+  *The points are split into groups of m points and the convex hull of every group is found with a monotone chain.
+  *Then the hull is wrapped like in Jarvis' March, but the next point of every group is found by a binary search on its hull.
+  *If the hull is not closed after m steps, m is squared and everything is repeated.
+  *The time complexity of the algorithm is O(nlogh) where h is no of points in convex hull.
+  *It is an output sensitive algorithm, much faster than the others when the hull is small.
+  *The hulls of the groups can be found with multiple threads.
+  *The user can also export the function to .ch format, as required by the assignment.
+  *For indepth description, plese see the individual function description.
+  */
+class Chan
+{
+/**
+  *\fn static Polygon convexHullChan(vector<Point> points, int threads)
+  *\param vector<Point> points
+  *\param int threads
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull with Chan's Algorithm
+  *
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners of the hull are returned, the points in the middle of an edge are not.
+  *threads is the number of threads used for the hulls of the groups, zero or less means the number of hardware threads.
+  *It returns a Polygon class. Refer to documentation of the class for details.
+  *
+  */
+public:
+	static Polygon convexHullChan(vector<Point> points, int threads = 1)
+	{
+		PointSet set(points);
+		vector<int> ch = ChanAlgo(set.getView(), threads);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points[i]);				//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullChanToCH(vector<Point> points, string filepath, int threads)
+  *\param vector<Point> points
+  *\param string filepath
+  *\param int threads
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull
+  *
+  *The function takes a vector of points and a file path as parameters.
+  *The convex hull of given set of points is calculated and saved as .ch file at the given filepath.
+  *Chan's Algorithm is used for finding the convex hull.
+  *The points are written in the order they were given and the indices refer to that order.
+  *For details on .ch file, contact Dr. T Ray from BITS Pilani University.
+  *
+  */
+public:
+	static void convexHullChanToCH(vector<Point> points, string filepath, int threads = 1)
+	{
+		PointSet set(points);
+		ExportToCH::write(points, ChanAlgo(set.getView(), threads), filepath);
+	}
+
+/**
+  *\fn static Polygon convexHullChan(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of a PointSet with Chan's Algorithm
+  *
+  *The points are not copied and the z co-ordinates are never read.
+  *
+  */
+public:
+	static Polygon convexHullChan(PointSetView points, int threads = 1)
+	{
+		vector<int> ch = ChanAlgo(points, threads);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullChanToCH(PointSetView points, string filepath, int threads)
+  *\param PointSetView points
+  *\param string filepath
+  *\param int threads
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull of a PointSet
+  *
+  *The points are written in the order they are stored in the set.
+  *
+  */
+public:
+	static void convexHullChanToCH(PointSetView points, string filepath, int threads = 1)
+	{
+		ExportToCH::write(points, ChanAlgo(points, threads), filepath);
+	}
+
+/**
+  *\fn static vector<int> convexHullChanIndices(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a PointSet
+  *
+  *The indices refer to the positions of the points in the set.
+  *
+  */
+public:
+	static vector<int> convexHullChanIndices(PointSetView points, int threads = 1)
+	{
+		return ChanAlgo(points, threads);
+	}
+
+/**
+  *\fn static vector<int> ChanAlgo(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return vector<int>
+  *
+  *\brief A private function with implementation of Chan's Algorithm
+  *
+  *m starts at 256 and is squared after every failed round, so there are O(loglogh) rounds.
+  *Smaller groups are not tried, the wrap over so many groups costs more than the sorting it saves.
+  *A round finds the hulls of the groups in O(nlogm) time and then wraps at most m points in O((n/m)mlogm) time.
+  *The round with m >= h closes the hull, which makes the total O(nlogh).
+  *A point which is not on the hull of its group can not be on the convex hull, so only the group hulls go to the next round.
+  *The returned indices refer to the positions in the view.
+  *
+  */
+private:
+	static vector<int> ChanAlgo(PointSetView points, int threads)
+	{
+		/**
+		  *\var vector<int> alive (local)
+		  *\brief The points which may still be on the hull, split into groups of m.
+		  *
+		  *\var vector<int> vertices (local)
+		  *\brief The hull of every group in anti-clockwise order, group i starts at i * (m + 1) as the chain may hold one extra point.
+		  *
+		  *\var vector<int> sizes (local)
+		  *\brief The number of points on the hull of every group.
+		  *
+		  *\var vector<int> offsets, hullindex (local)
+		  *\var vector<double> hullx, hully (local)
+		  *\brief All the group hulls one after another, with their co-ordinates next to each other for the binary searches.
+		  *
+		  *\var vector<int> result (local)
+		  *\brief The vector to store the resultant convex hull indices
+		  */
+		int iter, n = points.size;
+		const double *x = points.x, *y = points.y;
+		vector<int> result;
+		if(n == 0)
+			return result;
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 0)
+			threads = 1;
+
+		int start = 0;							//the first point on the hull
+		for(iter = 1; iter < n; iter++)
+			if(x[iter] < x[start] || (x[iter] == x[start] && y[iter] < y[start]))
+				start = iter;
+
+		vector<int> alive(n), vertices, sizes, offsets, hullindex;
+		vector<double> hullx, hully;
+		for(iter = 0; iter < n; iter++)
+			alive[iter] = iter;
+		for(int round = 3; ; round++)
+		{
+			//m = 2^(2^round), as long as it is less than the number of points left
+			int count = alive.size();
+			int m = (round < 5 && (1LL << (1 << round)) < count)? (1 << (1 << round)) : count;
+			int groups = (count + m - 1) / m;
+			sizes.assign(groups, 0);
+			vertices.resize((long long)groups * (m + 1));
+
+			int workers = min(threads, groups);
+			if(workers <= 1)
+				groupHulls(points, m, 0, groups, alive, vertices, sizes);
+			else
+			{
+				vector<thread> pool;
+				for(iter = 0; iter < workers; iter++)
+				{
+					int first = (long long)groups * iter / workers, last = (long long)groups * (iter + 1) / workers;
+					pool.push_back(thread([&points, m, first, last, &alive, &vertices, &sizes]() {
+						groupHulls(points, m, first, last, alive, vertices, sizes);
+					}));
+				}
+				for(thread &t : pool)
+					t.join();
+			}
+
+			offsets.assign(groups + 1, 0);
+			for(iter = 0; iter < groups; iter++)
+				offsets[iter + 1] = offsets[iter] + sizes[iter];
+			hullindex.resize(offsets[groups]);
+			hullx.resize(offsets[groups]);
+			hully.resize(offsets[groups]);
+			for(iter = 0; iter < groups; iter++)
+				for(int k = 0; k < sizes[iter]; k++)
+				{
+					int index = vertices[(long long)iter * (m + 1) + k];
+					hullindex[offsets[iter] + k] = index;
+					hullx[offsets[iter] + k] = x[index];
+					hully[offsets[iter] + k] = y[index];
+				}
+
+			//wrap the hull clockwise, at most m steps
+			result.clear();
+			result.push_back(start);
+			double px = x[start], py = y[start];
+			for(int step = 0; step < m; step++)
+			{
+				int next = -1;
+				for(int group = 0; group < groups; group++)
+				{
+					int position = tangent(hullx.data() + offsets[group], hully.data() + offsets[group], sizes[group], px, py);
+					if(position < 0)
+						continue;
+					int candidate = offsets[group] + position;
+					if(next < 0 || better(px, py, hullx[next], hully[next], hullx[candidate], hully[candidate]))
+						next = candidate;
+				}
+				if(next < 0 || (hullx[next] == x[start] && hully[next] == y[start]))
+					return result;				//all the points are the same or the hull is closed
+				result.push_back(hullindex[next]);
+				px = hullx[next];
+				py = hully[next];
+			}
+			if(m == count)						//can not happen, but do not loop forever on broken input
+				return result;
+			alive.swap(hullindex);
+		}
+	}
+
+/**
+  *\fn static void groupHulls(PointSetView &points, int m, int first, int last, vector<int> &alive, vector<int> &vertices, vector<int> &sizes)
+  *\param PointSetView &points
+  *\param int m the size of a group
+  *\param int first, last the range of groups to process
+  *\param vector<int> &alive, &vertices, &sizes refer to ChanAlgo
+  *
+  *\brief Find the hull of every group in the range with a monotone chain
+  *
+  *The points of a group are sorted in place, by x and then by y.
+  *The hull has no collinear or repeated points and is stored in anti-clockwise order, starting from the least point.
+  *It is the lower chain from left to right followed by the upper chain from right to left.
+  *Every group only writes to its own part of alive, vertices and sizes, so the ranges can be processed by different threads.
+  */
+private:
+	static void groupHulls(PointSetView &points, int m, int first, int last, vector<int> &alive, vector<int> &vertices, vector<int> &sizes)
+	{
+		const double *x = points.x, *y = points.y;
+		for(int group = first; group < last; group++)
+		{
+			int begin = group * m, end = min((int)alive.size(), begin + m);
+			int *sorted = alive.data() + begin, *hull = vertices.data() + (long long)group * (m + 1);
+			sort(sorted, sorted + (end - begin), [x, y](int a, int b) {
+				return (x[a] < x[b])? true:(x[a] > x[b])? false:(y[a] < y[b]);
+			});
+
+			int size = 0;
+			for(int i = 0; i < end - begin; i++)			//lower chain from left to right
+			{
+				while(size > 1 && !(turn(x[hull[size - 2]], y[hull[size - 2]], x[hull[size - 1]], y[hull[size - 1]], x[sorted[i]], y[sorted[i]]) > 0))
+					size--;
+				hull[size++] = sorted[i];
+			}
+			int lower = size;
+			for(int i = end - begin - 2; i >= 0; i--)		//upper chain from right to left
+			{
+				while(size > lower && !(turn(x[hull[size - 2]], y[hull[size - 2]], x[hull[size - 1]], y[hull[size - 1]], x[sorted[i]], y[sorted[i]]) > 0))
+					size--;
+				hull[size++] = sorted[i];
+			}
+			if(size > 1)
+				size--;								//the least point is repeated at the end
+			if(size == 2 && x[hull[0]] == x[hull[1]] && y[hull[0]] == y[hull[1]])
+				size = 1;							//all the points of the group are the same
+			sizes[group] = size;
+		}
+	}
+
+/**
+  *\fn static int tangent(const double *hx, const double *hy, int size, double px, double py)
+  *\param const double *hx, *hy the hull of a group in anti-clockwise order
+  *\param int size the number of points on the hull
+  *\param double px, py the current point of the wrap, a corner of the convex hull of all the points
+  *\return the position of the point of the hull that comes next after p in clockwise order, -1 if there is none
+  *
+  *\brief Find the point of a group hull with all the other points of the group on its right side, as seen from p
+  *
+  *If p is a corner of the group hull its clockwise neighbour is returned.
+  *Otherwise p is outside the group hull and the point with the largest angle as seen from p is found by a binary search.
+  *The angles along the hull go up once and down once, so the search compares a point with its neighbour and with the first point.
+  *If two points have the largest angle, the farther one is returned.
+  *Takes O(logsize) time.
+  */
+private:
+	static int tangent(const double *hx, const double *hy, int size, double px, double py)
+	{
+		int position = find(hx, hy, size, px, py);
+		if(position >= 0)
+			return (size > 1)? (position + size - 1) % size : -1;
+
+		//compare(i, j) > 0 if the angle of point j is larger than that of point i
+		auto compare = [&](int i, int j) {
+			double area = turn(px, py, hx[i % size], hy[i % size], hx[j % size], hy[j % size]);
+			return (area > 0)? 1 : (area < 0)? -1 : 0;
+		};
+		auto largest = [&](int i) {
+			return compare(i + 1, i) >= 0 && compare(i, i - 1 + size) < 0;
+		};
+
+		int low = 0, high = size;
+		if(!largest(0))
+			while(low + 1 < high)
+			{
+				int middle = (low + high) / 2;
+				if(largest(middle))
+				{
+					low = middle;
+					break;
+				}
+				int lowside = compare(low + 1, low), middleside = compare(middle + 1, middle);
+				if(lowside < middleside || (lowside == middleside && lowside == compare(low, middle)))
+					high = middle;
+				else
+					low = middle;
+			}
+
+		//when all the points of the group are on one line with p, both ends have the largest angle
+		int result = low, next = (low + 1) % size, previous = (low + size - 1) % size;
+		if(better(px, py, hx[result], hy[result], hx[next], hy[next]))
+			result = next;
+		if(better(px, py, hx[result], hy[result], hx[previous], hy[previous]))
+			result = previous;
+		return result;
+	}
+
+/**
+  *\fn static int find(const double *hx, const double *hy, int size, double px, double py)
+  *\param const double *hx, *hy the hull of a group in anti-clockwise order
+  *\param int size the number of points on the hull
+  *\param double px, py
+  *\return the position of the point (px, py) on the hull, -1 if it is not a corner
+  *
+  *\brief Binary search for a point among the corners of a group hull
+  *
+  *The lower chain is sorted by x and then by y, and the upper chain is sorted the other way.
+  */
+private:
+	static int find(const double *hx, const double *hy, int size, double px, double py)
+	{
+		auto less = [hx, hy](int a, double bx, double by) {
+			return (hx[a] < bx)? true:(hx[a] > bx)? false:(hy[a] < by);
+		};
+
+		int low = 0, high = size - 1;		//the position of the greatest point, where the chains meet
+		while(low < high)
+		{
+			int middle = (low + high + 1) / 2;
+			if(less(middle - 1, hx[middle], hy[middle]))
+				low = middle;
+			else
+				high = middle - 1;
+		}
+		int right = low;
+
+		low = 0;
+		high = right;
+		while(low < high)					//first point of the lower chain which is not less than p
+		{
+			int middle = (low + high) / 2;
+			if(less(middle, px, py))
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		if(hx[low] == px && hy[low] == py)
+			return low;
+
+		low = right;
+		high = size;
+		while(low < high)					//first point of the upper chain which is less than or equal to p
+		{
+			int middle = (low + high) / 2;
+			if(less(middle, px, py) || (hx[middle] == px && hy[middle] == py))
+				high = middle;
+			else
+				low = middle + 1;
+		}
+		if(low < size && hx[low] == px && hy[low] == py)
+			return low;
+		return -1;
+	}
+
+/**
+  *\fn static bool better(double px, double py, double ax, double ay, double bx, double by)
+  *\param double px, py the current point of the wrap
+  *\param double ax, ay, bx, by two candidates for the next point
+  *\return true if b should be taken instead of a
+  *
+  *\brief b is better if it is on the left of p to a, or on the same line and farther from p.
+  */
+private:
+	static bool better(double px, double py, double ax, double ay, double bx, double by)
+	{
+		double area = turn(px, py, ax, ay, bx, by);
+		if(area != 0)
+			return area > 0;
+		double da = (ax - px) * (ax - px) + (ay - py) * (ay - py);
+		double db = (bx - px) * (bx - px) + (by - py) * (by - py);
+		return db > da;
+	}
+
+/**
+  *\fn static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+  *\param double ax, ay, bx, by, cx, cy
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  *
+  *\brief The orientation test used by Chan's Algorithm
+  *
+  *It is Orientation::turn, computed with the differences to a and with the exact sign.
+  *The binary searches on the group hulls rely on the answers being consistent.
+  */
+private:
+	static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return Orientation::turn(ax, ay, bx, by, cx, cy);
+	}
+};
@@ -0,0 +1,500 @@
+/**\file: DynamicHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A convex hull which supports both insertion and removal of points.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The points are the leaves of a balanced binary tree, sorted by x and then by y, like in the structure of Overmars and van Leeuwen.
+  *Every inner node stores the bridge of its two children, which is the edge joining their upper hulls in the upper hull of the node,
+  *and the same for the lower hulls.
+  *The hull of a node is never stored: it is the hull of the left child up to the bridge followed by the hull of the right child from the bridge.
+  *So the bridges of the nodes below a node are enough to binary search on its hull.
+  *After an update only the bridges on the path to the root are found again, each with two nested binary searches.
+  *The tree is kept balanced by rebuilding the highest node whose children differ too much in size.
+  *An insertion or a removal takes O(log^3 n) amortized time, getting the hull takes O(hlogn) time.
+  *The lower hull is the upper hull of the points turned by 180 degrees, so the same code is used for both with the order of the children swapped.
+  *Points are identified by an id given by the user, e.g. their index in a vector, so the hull can be passed to ExportToCH::write with that vector.
+  */
+class DynamicHull
+{
+private:
+/**
+  *\var struct Node
+  *\brief A leaf with a point or an inner node with two children.
+  *
+  *size is the number of leaves below the node, low and high are the least and the greatest of them.
+  *bridge[side] holds the two leaves of the bridge, the first one in the first child of the side, see first().
+  *A leaf holds the ids of all the points at its co-ordinates, the first one stands for all of them in the hull.
+  */
+	struct Node
+	{
+		int left, right, parent, size, low, high;
+		int bridge[2][2];
+		double x, y;
+		vector<int> ids;
+	};
+
+/**
+  *\var vector<Node> nodes
+  *\brief All the nodes, the ones in unused are free.
+  *
+  *\var int root
+  *\brief The root of the tree, -1 if there are no points.
+  *
+  *\var unordered_map<int, pair<int, double>> where
+  *\brief For every id, its leaf and its z co-ordinate.
+  */
+	vector<Node> nodes;
+	vector<int> unused;
+	int root;
+	unordered_map<int, pair<int, double>> where;
+
+public:
+/**
+  *\brief A constructor for an empty hull.
+  */
+	DynamicHull()
+	{
+		root = -1;
+	}
+
+public:
+/**
+  *\fn void insert(int id, double x, double y, double z)
+  *\param int id
+  *\param double x
+  *\param double y
+  *\param double z
+  *
+  *\brief Insert the point (x, y, z) with the given id, in O(log^3 n) amortized time.
+  *
+  *If the id is already in the hull, its point is moved.
+  *z is only kept for toPolygon(), the hull is found in the xy plane.
+  */
+	void insert(int id, double x, double y, double z)
+	{
+		if(where.count(id))
+			erase(id);
+		if(root < 0)
+		{
+			root = newLeaf(x, y, id);
+			where[id] = make_pair(root, z);
+			return;
+		}
+
+		int v = root;
+		while(nodes[v].left >= 0)
+		{
+			int high = nodes[nodes[v].left].high;
+			v = (x < nodes[high].x || (x == nodes[high].x && y <= nodes[high].y))? nodes[v].left : nodes[v].right;
+		}
+		if(nodes[v].x == x && nodes[v].y == y)		//same co-ordinates, the hull does not change
+		{
+			nodes[v].ids.push_back(id);
+			where[id] = make_pair(v, z);
+			return;
+		}
+
+		int leaf = newLeaf(x, y, id);
+		where[id] = make_pair(leaf, z);
+		int parent = nodes[v].parent, inner = newNode();
+		bool before = x < nodes[v].x || (x == nodes[v].x && y < nodes[v].y);
+		nodes[inner].left = before? leaf : v;
+		nodes[inner].right = before? v : leaf;
+		nodes[inner].parent = parent;
+		nodes[leaf].parent = nodes[v].parent = inner;
+		replaceChild(parent, v, inner);
+		fix(inner);
+	}
+
+public:
+/**
+  *\fn void insert(int id, Point p)
+  *\param int id
+  *\param Point p
+  *
+  *\brief Insert p with the given id.
+  */
+	void insert(int id, Point p)
+	{
+		insert(id, p.x, p.y, p.z);
+	}
+
+public:
+/**
+  *\fn bool erase(int id)
+  *\param int id
+  *\return false if there is no point with the id
+  *
+  *\brief Remove the point with the given id, in O(log^3 n) amortized time.
+  */
+	bool erase(int id)
+	{
+		auto it = where.find(id);
+		if(it == where.end())
+			return false;
+		int leaf = it->second.first;
+		where.erase(it);
+		vector<int> &ids = nodes[leaf].ids;
+		ids.erase(find(ids.begin(), ids.end(), id));
+		if(!ids.empty())							//other points are at the same co-ordinates
+			return true;
+
+		int parent = nodes[leaf].parent;
+		freeNode(leaf);
+		if(parent < 0)
+		{
+			root = -1;
+			return true;
+		}
+		int sibling = (nodes[parent].left == leaf)? nodes[parent].right : nodes[parent].left;
+		int grandparent = nodes[parent].parent;
+		nodes[sibling].parent = grandparent;
+		replaceChild(grandparent, parent, sibling);
+		freeNode(parent);
+		if(grandparent >= 0)
+			fix(grandparent);
+		return true;
+	}
+
+public:
+/**
+  *\fn int getCount(void) const
+  *\return the number of points in the hull structure
+  */
+	int getCount(void) const
+	{
+		return where.size();
+	}
+
+public:
+/**
+  *\fn vector<int> getIndices(void) const
+  *\return the ids of the corners of the hull
+  *
+  *\brief Get the hull in O(hlogn) time.
+  *
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners are kept. If several points have the same co-ordinates, the one inserted first stands for them.
+  */
+	vector<int> getIndices(void) const
+	{
+		vector<int> leaves, result;
+		if(root < 0)
+			return result;
+		enumerate(root, 0, -1, -1, leaves);				//upper hull from left to right
+		int upper = leaves.size();
+		enumerate(root, 1, -1, -1, leaves);				//lower hull from right to left
+		for(int iter = 0; iter < (int)leaves.size(); iter++)
+		{
+			if(iter == upper && leaves[iter] == leaves[iter - 1])
+				continue;								//the greatest point ends the upper hull and starts the lower one
+			if(iter == (int)leaves.size() - 1 && iter > 0 && leaves[iter] == leaves[0])
+				continue;								//the least point is at both ends
+			result.push_back(nodes[leaves[iter]].ids[0]);
+		}
+		return result;
+	}
+
+public:
+/**
+  *\fn Polygon toPolygon(void) const
+  *\return Polygon which is the convex hull of the points
+  */
+	Polygon toPolygon(void) const
+	{
+		Polygon result;									//create a polygon
+		for(int id : getIndices())
+		{
+			pair<int, double> leaf = where.at(id);
+			result.insertAtLast(Point(nodes[leaf.first].x, nodes[leaf.first].y, leaf.second));
+		}
+		return result;
+	}
+
+/**
+  *\fn int first(int v, int side) const
+  *\fn int second(int v, int side) const
+  *\return the child of v whose points come first or second in the order of the side
+  *
+  *\fn bool before(int a, int b, int side) const
+  *\return true if the leaf a comes before the leaf b in the order of the side
+  *
+  *\brief Side 0 is the upper hull with the points in their order, side 1 is the lower hull with the order reversed.
+  */
+private:
+	int first(int v, int side) const
+	{
+		return side? nodes[v].right : nodes[v].left;
+	}
+
+	int second(int v, int side) const
+	{
+		return side? nodes[v].left : nodes[v].right;
+	}
+
+	bool before(int a, int b, int side) const
+	{
+		if(side)
+			swap(a, b);
+		return nodes[a].x < nodes[b].x || (nodes[a].x == nodes[b].x && nodes[a].y < nodes[b].y);
+	}
+
+/**
+  *\fn template<class Test> int search(int v, int side, Test goRight) const
+  *\param int v
+  *\param int side
+  *\param Test goRight called with the two ends of an edge of the hull of v
+  *\return the corner of the hull of v where goRight changes from true to false
+  *
+  *\brief Binary search on the hull of v, using the bridges of the nodes below it.
+  *
+  *The part of the hull of v below the current node is its hull between the corners low and high.
+  *If the bridge of the node is in that part it is an edge of the hull of v and is tested, otherwise the part is on one side of it.
+  *Takes O(logn) calls of goRight.
+  */
+private:
+	template<class Test>
+	int search(int v, int side, Test goRight) const
+	{
+		int low = -1, high = -1;
+		while(nodes[v].left >= 0)
+		{
+			int a = nodes[v].bridge[side][0], b = nodes[v].bridge[side][1];
+			if(low >= 0 && before(a, low, side))
+				v = second(v, side);
+			else if(high >= 0 && before(high, b, side))
+				v = first(v, side);
+			else if(goRight(a, b))
+			{
+				low = b;
+				v = second(v, side);
+			}
+			else
+			{
+				high = a;
+				v = first(v, side);
+			}
+		}
+		return v;
+	}
+
+/**
+  *\fn int tangent(int v, int p, int side) const
+  *\return the corner of the hull of v touched by the tangent from the point p, which comes before all of them
+  *
+  *\brief If several corners are on the tangent, the last one is taken.
+  */
+private:
+	int tangent(int v, int p, int side) const
+	{
+		return search(v, side, [this, p](int a, int b) {
+			return turn(p, a, b) >= 0;
+		});
+	}
+
+/**
+  *\fn void findBridge(int v, int side)
+  *
+  *\brief Find the bridge of v, in O(log^2 n) time.
+  *
+  *The corner p of the first hull is found by a binary search.
+  *An edge a to b of the first hull is before p if a is below the tangent from b to the second hull.
+  *The other corner is then the tangent from p.
+  *If the bridge touches several corners of one line, it is taken as long as possible so that no corner of the hull is in the middle of an edge.
+  */
+private:
+	void findBridge(int v, int side)
+	{
+		int a = first(v, side), b = second(v, side);
+		int p = search(a, side, [this, b, side](int c, int d) {
+			return turn(c, d, tangent(b, d, side)) < 0;
+		});
+		nodes[v].bridge[side][0] = p;
+		nodes[v].bridge[side][1] = tangent(b, p, side);
+	}
+
+/**
+  *\fn void enumerate(int v, int side, int low, int high, vector<int> &out) const
+  *
+  *\brief Append the corners of the hull of v between low and high to out, -1 for no limit.
+  */
+private:
+	void enumerate(int v, int side, int low, int high, vector<int> &out) const
+	{
+		if(nodes[v].left < 0)
+		{
+			out.push_back(v);
+			return;
+		}
+		int a = nodes[v].bridge[side][0], b = nodes[v].bridge[side][1];
+		if(low < 0 || !before(a, low, side))
+			enumerate(first(v, side), side, low, (high >= 0 && before(high, a, side))? high : a, out);
+		if(high < 0 || !before(high, b, side))
+			enumerate(second(v, side), side, (low >= 0 && before(b, low, side))? low : b, high, out);
+	}
+
+/**
+  *\fn void fix(int v)
+  *
+  *\brief Update the nodes from v to the root after a leaf below v was added or removed.
+  *
+  *The highest node whose larger child has more than three quarters of its leaves is rebuilt, which keeps the height O(logn).
+  *Then the bridges are found again from there, or from v, up to the root.
+  */
+private:
+	void fix(int v)
+	{
+		int unbalanced = -1;
+		for(int u = v; u >= 0; u = nodes[u].parent)
+		{
+			update(u, false);
+			int larger = max(nodes[nodes[u].left].size, nodes[nodes[u].right].size);
+			if(nodes[u].size > 4 && 4 * larger > 3 * nodes[u].size)
+				unbalanced = u;
+		}
+		if(unbalanced >= 0)
+		{
+			int parent = nodes[unbalanced].parent;
+			rebuild(unbalanced);
+			v = parent;
+		}
+		for(int u = v; u >= 0; u = nodes[u].parent)
+			update(u, true);
+	}
+
+/**
+  *\fn void update(int v, bool bridges)
+  *
+  *\brief Update the size and the least and greatest leaves of an inner node from its children, and its bridges if asked.
+  */
+private:
+	void update(int v, bool bridges)
+	{
+		int l = nodes[v].left, r = nodes[v].right;
+		nodes[v].size = nodes[l].size + nodes[r].size;
+		nodes[v].low = nodes[l].low;
+		nodes[v].high = nodes[r].high;
+		if(bridges)
+		{
+			findBridge(v, 0);
+			findBridge(v, 1);
+		}
+	}
+
+/**
+  *\fn void rebuild(int v)
+  *
+  *\brief Replace the subtree of v by a perfectly balanced one with the same leaves.
+  */
+private:
+	void rebuild(int v)
+	{
+		vector<int> leaves;
+		collect(v, leaves);
+		int parent = nodes[v].parent;
+		int top = build(leaves, 0, leaves.size());
+		nodes[top].parent = parent;
+		replaceChild(parent, v, top);
+	}
+
+	void collect(int v, vector<int> &leaves)
+	{
+		if(nodes[v].left < 0)
+		{
+			leaves.push_back(v);
+			return;
+		}
+		collect(nodes[v].left, leaves);
+		collect(nodes[v].right, leaves);
+		freeNode(v);
+	}
+
+	int build(vector<int> &leaves, int begin, int end)
+	{
+		if(end - begin == 1)
+			return leaves[begin];
+		int middle = (begin + end) / 2;
+		int l = build(leaves, begin, middle), r = build(leaves, middle, end);
+		int v = newNode();
+		nodes[v].left = l;
+		nodes[v].right = r;
+		nodes[l].parent = nodes[r].parent = v;
+		update(v, true);
+		return v;
+	}
+
+/**
+  *\fn void replaceChild(int parent, int from, int to)
+  *
+  *\brief Put to in the place of the child from of parent, or make it the root if parent is -1.
+  */
+private:
+	void replaceChild(int parent, int from, int to)
+	{
+		if(parent < 0)
+			root = to;
+		else if(nodes[parent].left == from)
+			nodes[parent].left = to;
+		else
+			nodes[parent].right = to;
+	}
+
+/**
+  *\fn int newNode(void)
+  *\fn int newLeaf(double x, double y, int id)
+  *\fn void freeNode(int v)
+  *
+  *\brief The nodes are taken from and given back to unused, so that the vector does not grow with every update.
+  */
+private:
+	int newNode(void)
+	{
+		int v;
+		if(unused.empty())
+		{
+			v = nodes.size();
+			nodes.push_back(Node());
+		}
+		else
+		{
+			v = unused.back();
+			unused.pop_back();
+		}
+		nodes[v].left = nodes[v].right = nodes[v].parent = -1;
+		nodes[v].size = 1;
+		nodes[v].low = nodes[v].high = v;
+		nodes[v].ids.clear();
+		return v;
+	}
+
+	int newLeaf(double x, double y, int id)
+	{
+		int v = newNode();
+		nodes[v].x = x;
+		nodes[v].y = y;
+		nodes[v].ids.push_back(id);
+		return v;
+	}
+
+	void freeNode(int v)
+	{
+		unused.push_back(v);
+	}
+
+/**
+  *\fn double turn(int a, int b, int c) const
+  *\return twice the signed area of the triangle of the leaves a, b and c, positive if c is on the left of a to b
+  *
+  *\brief Orientation::turn like the one of Chan's Algorithm. Turning the points by 180 degrees does not change it.
+  */
+private:
+	double turn(int a, int b, int c) const
+	{
+		const Node &p = nodes[a], &q = nodes[b], &r = nodes[c];
+		return Orientation::turn(p.x, p.y, q.x, q.y, r.x, r.y);
+	}
+};
@@ -61,8 +61,104 @@ public:
 	}
 
 /**
-  *\fn pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points)
+  *\fn static Polygon convexHullGraham(vector<Point> points, HullOptions options)
   *\param vector<Point> points
+  *\param HullOptions options
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull with Graham Scan Algorithm and the optional stages in options
+  *
+  *With options.prefilter the points which can not be on the hull are dropped before sorting.
+  *
+  */
+public:
+	static Polygon convexHullGraham(vector<Point> points, HullOptions options)
+	{
+		pair<vector<int>, vector<Point>> p = GrahamScanAlgo(points, options);
+		Polygon result;									//create a polygon
+		for(int i : p.first)
+			result.insertAtLast(p.second[i]);			//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullGrahamToCH(vector<Point> points, string filepath, HullOptions options)
+  *\param vector<Point> points
+  *\param string filepath
+  *\param HullOptions options
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull with the optional stages in options
+  *
+  */
+public:
+	static void convexHullGrahamToCH(vector<Point> points, string filepath, HullOptions options)
+	{
+		pair<vector<int>, vector<Point>> p = GrahamScanAlgo(points, options);
+		ExportToCH::write(p.second, p.first, filepath);
+	}
+
+/**
+  *\fn static Polygon convexHullGraham(PointSetView points, HullOptions options)
+  *\param PointSetView points
+  *\param HullOptions options
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of a PointSet with Graham Scan Algorithm
+  *
+  *The points are not copied, only an array of indices is sorted by the angle.
+  *The z co-ordinates are never read.
+  *
+  */
+public:
+	static Polygon convexHullGraham(PointSetView points, HullOptions options = HullOptions())
+	{
+		vector<int> ch = GrahamScanAlgo(points, options);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullGrahamToCH(PointSetView points, string filepath, HullOptions options)
+  *\param PointSetView points
+  *\param string filepath
+  *\param HullOptions options
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull of a PointSet
+  *
+  *The points are written in the order they are stored in the set.
+  *
+  */
+public:
+	static void convexHullGrahamToCH(PointSetView points, string filepath, HullOptions options = HullOptions())
+	{
+		ExportToCH::write(points, GrahamScanAlgo(points, options), filepath);
+	}
+
+/**
+  *\fn static vector<int> convexHullGrahamIndices(PointSetView points, HullOptions options)
+  *\param PointSetView points
+  *\param HullOptions options
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a PointSet
+  *
+  *The indices refer to the positions of the points in the set.
+  *
+  */
+public:
+	static vector<int> convexHullGrahamIndices(PointSetView points, HullOptions options = HullOptions())
+	{
+		return GrahamScanAlgo(points, options);
+	}
+
+/**
+  *\fn pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points, bool prefilter)
+  *\param vector<Point> points
+  *\param bool prefilter
   *\return pair<vector<int>, vector<Point>>
   *
   *\brief A private function with implementation of Graham Scan Algorithm for finding convex hull
@@ -73,10 +169,15 @@ public:
   *Then by recursively analyzing the direction of three consicutive points, convex hull is generated.
   *Wrapper pulbic classes to provide proper output formats are present.
   *Look at them if you intend to call it from outside.
+  *With prefilter, only the points kept by AklToussaint::filter are sorted and scanned.
+  *Their angles are computed exactly as without it, so the result is the same.
+  *Points with the same angle are on one ray from the interior point and only the farthest of them is scanned,
+  *so the rightmost point is the first one and the nearer points are never kept on the hull as a spike.
+  *Of the copies of a point only the one with the least index is on the hull.
   *
   */
 private:
-	static pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points)
+	static pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points, bool prefilter = false)
 	{
 		/**
 		  *\var Line direction (local)
@@ -114,13 +215,32 @@ private:
 			return {result, points};
 		}
 
+		vector<int> kept;
+		if(prefilter)
+			kept = AklToussaint::filter(PointSet(points));
+		else
+			for(iter = 0; iter < polar.size(); iter++)
+				kept.push_back(iter);
 		vector<pair<SphericalPoint, int>> sortedpoints;
-		for(iter = 0; iter < polar.size(); iter++)
-			sortedpoints.push_back({polar[iter], iter});		//enter the index and point in sortedpoints
+		for(int i : kept)
+			sortedpoints.push_back({polar[i], i});			//enter the index and point in sortedpoints
 		//sort the vector with inbuilt function and passing lambda function to compare
-		sort(sortedpoints.begin(), sortedpoints.end(), [](pair<SphericalPoint, int> const& A, pair<SphericalPoint, int> const& B) {
-			return (A.first.theta < B.first.theta)? true:false;
+		//points with the same theta are on one ray from the origin, the farthest comes first and the rest by index
+		stable_sort(sortedpoints.begin(), sortedpoints.end(), [](pair<SphericalPoint, int> const& A, pair<SphericalPoint, int> const& B) {
+			if(A.first.theta != B.first.theta)
+				return A.first.theta < B.first.theta;
+			return A.first.radius > B.first.radius;
 		});	//end of lambda function
+		//only the farthest point of a ray can be on the hull, the nearer ones and the copies of it are not scanned
+		sortedpoints.erase(unique(sortedpoints.begin(), sortedpoints.end(), [](pair<SphericalPoint, int> const& A, pair<SphericalPoint, int> const& B) {
+			return A.first.theta == B.first.theta;
+		}), sortedpoints.end());
+		if(sortedpoints.size() < 3)
+		{
+			for(pair<SphericalPoint, int> const& p : sortedpoints)
+				result.push_back(p.second);
+			return {result, points};
+		}
 
 		//for the initialization of the temp.
 		//we insert the last point, the first point and the second point.
@@ -136,7 +256,7 @@ private:
 		{
 			temp.push_back(sortedpoints[iter++ % sortedpoints.size()]);
 			result.push_back(temp.back().second);
-			while(checkDirection(points[temp[temp.size() - 1].second], points[temp[temp.size() - 2].second], points[temp[temp.size() - 3].second]))
+			while(temp.size() > 3 && Orientation::checkDirection(points[temp[temp.size() - 1].second], points[temp[temp.size() - 2].second], points[temp[temp.size() - 3].second]))
 			{
 				temp.erase(temp.end() - 2);				//If the middle point gets inside the two end of last three points, it is deleted.
 				result.erase(result.end() - 2);
@@ -147,24 +267,191 @@ private:
 	}
 
 /**
-  *\fn checkDirection(Point a, Point b, Point c)
-  *\param Point a
-  *\param Point b
-  *\param Point c
-  *\return a boolean indicating the sign of area
+  *\fn static pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points, HullOptions options)
+  *\param vector<Point> points
+  *\param HullOptions options
+  *\return pair<vector<int>, vector<Point>>
+  *
+  *\brief A private function to get convex hull with the optional stages in options
+  *
+  *Without any option it is the same as GrahamScanAlgo(points).
+  *With options.prefilter alone the angles and the sort are the same, so the points and the indices are the same as without it.
+  *Otherwise the points are converted to a PointSet.
+  *
+  */
+private:
+	static pair<vector<int>, vector<Point>> GrahamScanAlgo(vector<Point> points, HullOptions options)
+	{
+		if(!options.pseudoAngle && !options.radixSort)
+			return GrahamScanAlgo(points, options.prefilter);
+		PointSet set(points);
+		return {GrahamScanAlgo(set.getView(), options), points};
+	}
+
+/**
+  *\fn static vector<int> GrahamScanAlgo(PointSetView points, HullOptions options)
+  *\param PointSetView points
+  *\param HullOptions options
+  *\return vector<int>
+  *
+  *\brief A private function with implementation of Graham Scan Algorithm for a PointSetView
+  *
+  *It is the same algorithm as above.
+  *Only the angles of the points are computed, in radians, instead of converting all the points to SphericalPoint.
+  *An array of indices is sorted by these angles.
+  *With options.prefilter, the points dropped by AklToussaint::filter are not sorted.
+  *The interior point and the direction are still computed from all the points.
+  *With options.pseudoAngle, the angles are replaced by pseudoAngle, so no trigonometric function is called.
+  *With options.radixSort, the indices are sorted by RadixSort::sortBy.
+  *Of the points with the same angle only the farthest is scanned, as above, whatever order the sort left them in.
+  *
+  */
+private:
+	static vector<int> GrahamScanAlgo(PointSetView points, HullOptions options)
+	{
+		/**
+		  *\var vector<double> theta (local)
+		  *\brief The angle of every point around the interior point, measured from the direction of the rightmost point
+		  *
+		  *\var vector<int> sortedpoints (local)
+		  *\brief The indices of the points sorted in increasing theta
+		  *
+		  *\var vector<int> temp (local)
+		  *\brief The indices used instead of the stack required in the implementation.
+		  */
+		int iter;
+		int n = points.size;
+		vector<int> result;
+
+		//If the points are less than or equal to three, all of them are in convex hull.
+		if(n <= 3)
+		{
+			for(iter = 0; iter < n; iter++)
+				result.push_back(iter);
+			return result;
+		}
+
+		const double *x = points.x, *y = points.y;
+		double cx = 0, cy = 0;					//interior point for origin
+		int right = 0;							//rightmost point for direction
+		for(iter = 0; iter < n; iter++)
+		{
+			cx += x[iter];
+			cy += y[iter];
+			if(x[iter] > x[right] || (x[iter] == x[right] && y[iter] > y[right]))
+				right = iter;
+		}
+		cx = cx / n;
+		cy = cy / n;
+
+		vector<int> sortedpoints;
+		if(options.prefilter)
+			sortedpoints = AklToussaint::filter(points);
+		else
+		{
+			sortedpoints.resize(n);
+			for(iter = 0; iter < n; iter++)
+				sortedpoints[iter] = iter;
+		}
+		n = sortedpoints.size();
+
+		vector<double> theta(points.size);
+		if(options.pseudoAngle)
+		{
+			double direction = pseudoAngle(x[right] - cx, y[right] - cy);
+			for(int i : sortedpoints)
+			{
+				theta[i] = pseudoAngle(x[i] - cx, y[i] - cy) - direction;
+				if(theta[i] < 0)
+					theta[i] += 4;				//a full turn is 4
+			}
+		}
+		else
+		{
+			double direction = atan2(y[right] - cy, x[right] - cx);
+			for(int i : sortedpoints)
+			{
+				theta[i] = atan2(y[i] - cy, x[i] - cx) - direction;
+				if(theta[i] < 0)
+					theta[i] += 2 * acos(-1.0);	//to ensure angle is positive
+			}
+		}
+		if(options.radixSort)
+			RadixSort::sortBy(theta.data(), sortedpoints, options.sortThreads);
+		else
+			sort(sortedpoints.begin(), sortedpoints.end(), [&theta](int A, int B) {
+				return theta[A] < theta[B];
+			});
+
+		//only the farthest point of a ray can be on the hull, of its copies the one with the least index is kept
+		int kept = 0;
+		for(iter = 0; iter < n; iter++)
+		{
+			int i = sortedpoints[iter];
+			if(kept == 0 || theta[i] != theta[sortedpoints[kept - 1]])
+				sortedpoints[kept++] = i;
+			else if(isFarther(x, y, cx, cy, i, sortedpoints[kept - 1]))
+				sortedpoints[kept - 1] = i;
+		}
+		n = kept;
+		sortedpoints.resize(n);
+		if(n < 3)
+			return sortedpoints;
+
+		vector<int> temp;
+		temp.push_back(sortedpoints[n - 1]);
+		temp.push_back(sortedpoints[0]);
+		temp.push_back(sortedpoints[1]);
+		result.push_back(sortedpoints[1]);
+
+		iter = 2;
+		while(iter <= n)						//a loop to insert points in result
+		{
+			temp.push_back(sortedpoints[iter++ % n]);
+			result.push_back(temp.back());
+			while(temp.size() > 3 && Orientation::checkDirection(points, temp[temp.size() - 1], temp[temp.size() - 2], temp[temp.size() - 3]))
+			{
+				temp.erase(temp.end() - 2);		//If the middle point gets inside the two end of last three points, it is deleted.
+				result.erase(result.end() - 2);
+			}
+		}
+
+		return result;
+	}
+
+/**
+  *\fn static bool isFarther(const double *x, const double *y, double cx, double cy, int a, int b)
+  *\return true if the point a is farther from (cx, cy) than the point b, or as far with a smaller index
+  *
+  *\brief The order of the points on one ray in GrahamScanAlgo, the same as the stable sort by decreasing radius.
+  */
+private:
+	static bool isFarther(const double *x, const double *y, double cx, double cy, int a, int b)
+	{
+		double ra = (x[a] - cx) * (x[a] - cx) + (y[a] - cy) * (y[a] - cy);
+		double rb = (x[b] - cx) * (x[b] - cx) + (y[b] - cy) * (y[b] - cy);
+		return ra > rb || (ra == rb && a < b);
+	}
+
+/**
+  *\fn static double pseudoAngle(double dx, double dy)
+  *\param double dx, dy a vector
+  *\return a number from 0 to 4 which grows with the angle of the vector from the x axis, like atan2 from 0 to 2 pi
   *
-  *\brief Check the sign of area
+  *\brief The diamond angle, i.e. the position along the square |x| + |y| = 1 where the vector crosses it.
   *
-  *Returns true if the signed area of the triangle abc is positive
-  *else returns false.
+  *It is not the angle itself, but two vectors are in the same order by both of them.
+  *Every quadrant is 1, so it takes one division and no trigonometric function.
+  *The zero vector gets 0, like atan2(0, 0).
   */
 private:
-	static bool checkDirection(Point a, Point b, Point c)
+	static double pseudoAngle(double dx, double dy)
 	{
-		double area = a.x * b.y - b.x * a.y + b.x * c.y - c.x * b.y + c.x * a.y - a.x * c.y;	//area of the triangle * 2
-		if(area > 0)
-			return true;
-		return false;
+		if(dx == 0 && dy == 0)
+			return 0;
+		if(dy >= 0)
+			return (dx >= 0) ? dy / (dx + dy) : 1 - dx / (dy - dx);
+		return (dx < 0) ? 2 - dy / (-dx - dy) : 3 + dx / (dx - dy);
 	}
 
 /**
@@ -0,0 +1,59 @@
+/**\file: HullOptions.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A class to hold the optional stages of the hull algorithms.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The hull algorithms accept a HullOptions to switch the optional stages on or off.
+  *A default constructed HullOptions gives the plain algorithm.
+  *Every option is independent of the others, set only the ones required.
+  */
+class HullOptions
+{
+public:
+/**
+  *\var bool prefilter
+  *\brief If true, the points strictly inside the octagon of the extreme points are dropped before the hull is computed.
+  *
+  *Refer to the AklToussaint class for details.
+  *It is very effective on uniformly distributed points but does not help when most of the points are on the hull.
+  */
+	bool prefilter;
+
+public:
+/**
+  *\var bool radixSort
+  *\brief If true, the points are sorted with RadixSort instead of std::sort, by x and then by y in Andrew's Algorithm and by angle in Graham Scan.
+  *
+  *It is faster for large sets of points, refer to the RadixSort class for details.
+  *
+  *\var int sortThreads
+  *\brief The number of threads of the radix sort, zero or less means the number of hardware threads.
+  */
+	bool radixSort;
+	int sortThreads;
+
+public:
+/**
+  *\var bool pseudoAngle
+  *\brief If true, Graham Scan sorts the points by a pseudo angle which needs a single division instead of atan2.
+  *
+  *The pseudo angle grows with the angle, so the order of the points is the same. Refer to GrahamScan::pseudoAngle for details.
+  */
+	bool pseudoAngle;
+
+public:
+/**
+  *\brief A constructor with all the optional stages switched off.
+  */
+	HullOptions()
+	{
+		prefilter = false;
+		radixSort = false;
+		sortThreads = 1;
+		pseudoAngle = false;
+	}
+};
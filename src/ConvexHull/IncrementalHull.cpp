@@ -0,0 +1,263 @@
+/**\file: IncrementalHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A convex hull which is updated as the points are inserted one by one.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The hull is kept as an upper and a lower chain, each in a balanced search tree (std::map) sorted by x.
+  *A new point is looked up in both chains in O(logn) time.
+  *If it is outside a chain, it is put in and its neighbours on either side are removed as long as they are no longer corners,
+  *which is where the tangents from the new point touch the chain.
+  *Every point is removed at most once, so an insertion takes O(logn) amortized time.
+  *All the inserted points are stored as well, so the hull can be exported to .ch with the indices of the points.
+  *Getting the hull as a Polygon or the indices takes O(h) time.
+  */
+class IncrementalHull
+{
+private:
+/**
+  *\var PointSet points
+  *\brief All the inserted points, in the order of insertion.
+  *
+  *\var map<double, pair<double, int>> upper
+  *\brief The corners of the upper chain, from x to the y co-ordinate and the index of the point.
+  *
+  *\var map<double, pair<double, int>> lower
+  *\brief The corners of the lower chain, stored like upper with the y co-ordinates negated.
+  */
+	PointSet points;
+	map<double, pair<double, int>> upper, lower;
+
+public:
+/**
+  *\brief A constructor for an empty hull.
+  */
+	IncrementalHull() : points(true)
+	{
+	}
+
+public:
+/**
+  *\fn int insert(double x, double y, double z)
+  *\param double x
+  *\param double y
+  *\param double z
+  *\return the index of the point, which is the number of points inserted before it
+  *
+  *\brief Insert the point (x, y, z) and update the hull in O(logn) amortized time.
+  *
+  *z is only stored for the export, the hull is found in the xy plane.
+  */
+	int insert(double x, double y, double z)
+	{
+		int index = points.getSize();
+		points.insertAtLast(x, y, z);
+		insertInChain(upper, x, y, index);
+		insertInChain(lower, x, -y, index);
+		return index;
+	}
+
+public:
+/**
+  *\fn int insert(double x, double y)
+  *\param double x
+  *\param double y
+  *\return the index of the point
+  *
+  *\brief Insert the point (x, y, 0).
+  */
+	int insert(double x, double y)
+	{
+		return insert(x, y, 0.0);
+	}
+
+public:
+/**
+  *\fn int insert(Point p)
+  *\param Point p
+  *\return the index of the point
+  *
+  *\brief Insert p.
+  */
+	int insert(Point p)
+	{
+		return insert(p.x, p.y, p.z);
+	}
+
+public:
+/**
+  *\fn bool contains(double x, double y) const
+  *\param double x
+  *\param double y
+  *\return true if (x, y) is inside the hull or on its boundary
+  *
+  *\brief Check a point against the hull in O(logn) time, without inserting it.
+  */
+	bool contains(double x, double y) const
+	{
+		return !upper.empty() && belowChain(upper, x, y) && belowChain(lower, x, -y);
+	}
+
+public:
+/**
+  *\fn int getCount(void) const
+  *\return the number of points inserted so far
+  */
+	int getCount(void) const
+	{
+		return points.getSize();
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return the number of corners of the hull
+  */
+	int getSize(void) const
+	{
+		return getIndices().size();
+	}
+
+public:
+/**
+  *\fn vector<int> getIndices(void) const
+  *\return the indices of the corners of the hull
+  *
+  *\brief Get the hull in O(h) time.
+  *
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners are kept, a point in the middle of an edge is never part of the hull.
+  */
+	vector<int> getIndices(void) const
+	{
+		vector<int> result;
+		if(upper.empty())
+			return result;
+		result.push_back(lower.begin()->second.second);
+		for(auto it = upper.begin(); it != upper.end(); it++)					//upper chain from left to right
+			if(!samePoint(it->second.second, result.back()))
+				result.push_back(it->second.second);
+		for(auto it = lower.rbegin(); it != prev(lower.rend()); it++)			//lower chain from right to left, without the start
+			if(!samePoint(it->second.second, result.back()))
+				result.push_back(it->second.second);
+		return result;
+	}
+
+public:
+/**
+  *\fn Polygon toPolygon(void) const
+  *\return Polygon which is the convex hull of the points inserted so far
+  */
+	Polygon toPolygon(void) const
+	{
+		Polygon result;									//create a polygon
+		for(int i : getIndices())
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+public:
+/**
+  *\fn void toCH(string filepath) const
+  *\param string filepath
+  *
+  *\brief Save all the inserted points and the hull as .ch file at the given filepath.
+  */
+	void toCH(string filepath) const
+	{
+		ExportToCH::write(points.getView(), getIndices(), filepath);
+	}
+
+/**
+  *\fn static void insertInChain(map<double, pair<double, int>> &chain, double x, double y, int index)
+  *\param map<double, pair<double, int>> &chain
+  *\param double x, y the point, with y negated for the lower chain
+  *\param int index
+  *
+  *\brief Insert a point in an upper chain, if it is above it.
+  *
+  *The chain turns clockwise from left to right, there is a single point for every x.
+  *The neighbours of the new point are removed while they do not make a clockwise turn with it,
+  *first on the right side and then on the left side.
+  */
+private:
+	static void insertInChain(map<double, pair<double, int>> &chain, double x, double y, int index)
+	{
+		if(!chain.empty() && belowChain(chain, x, y))
+			return;
+		auto it = chain.find(x);
+		if(it != chain.end())
+			it->second = make_pair(y, index);		//the point is above the one with the same x
+		else
+			it = chain.insert(make_pair(x, make_pair(y, index))).first;
+
+		while(true)									//right side
+		{
+			auto next = std::next(it);
+			if(next == chain.end() || std::next(next) == chain.end())
+				break;
+			auto after = std::next(next);
+			if(turn(x, y, next->first, next->second.first, after->first, after->second.first) < 0)
+				break;
+			chain.erase(next);
+		}
+		while(it != chain.begin())					//left side
+		{
+			auto previous = std::prev(it);
+			if(previous == chain.begin())
+				break;
+			auto before = std::prev(previous);
+			if(turn(before->first, before->second.first, previous->first, previous->second.first, x, y) < 0)
+				break;
+			chain.erase(previous);
+		}
+	}
+
+/**
+  *\fn static bool belowChain(const map<double, pair<double, int>> &chain, double x, double y)
+  *\param const map<double, pair<double, int>> &chain
+  *\param double x, y
+  *\return true if the point is below the chain or on it, within the range of x of the chain
+  */
+private:
+	static bool belowChain(const map<double, pair<double, int>> &chain, double x, double y)
+	{
+		auto it = chain.lower_bound(x);
+		if(it == chain.end())
+			return false;
+		if(it->first == x)
+			return y <= it->second.first;
+		if(it == chain.begin())
+			return false;
+		auto previous = std::prev(it);
+		return turn(previous->first, previous->second.first, it->first, it->second.first, x, y) <= 0;
+	}
+
+/**
+  *\fn bool samePoint(int a, int b) const
+  *\return true if both points have the same x and y co-ordinates
+  *
+  *\brief The ends of the chains are shared by both of them, they are written only once.
+  */
+private:
+	bool samePoint(int a, int b) const
+	{
+		Point p = points.getPoint(a), q = points.getPoint(b);
+		return p.x == q.x && p.y == q.y;
+	}
+
+/**
+  *\fn static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  *
+  *\brief The orientation test, Orientation::turn like the one of Chan's Algorithm.
+  */
+private:
+	static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return Orientation::turn(ax, ay, bx, by, cx, cy);
+	}
+};
@@ -64,6 +64,60 @@ public:
 		ExportToCH::write(p.second, p.first, filepath);
 	}
 
+/**
+  *\fn static Polygon convexHullJarvis(PointSetView points)
+  *\param PointSetView points
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of a PointSet with Gift Wrapping Algorithm
+  *
+  *The points are not copied and the z co-ordinates are never read.
+  *Every step of the march scans the x and y arrays from start to end.
+  *
+  */
+public:
+	static Polygon convexHullJarvis(PointSetView points)
+	{
+		vector<int> ch = JarvisAlgo(points);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullJarvisToCH(PointSetView points, string filepath)
+  *\param PointSetView points
+  *\param string filepath
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull of a PointSet
+  *
+  *The points are written in the order they are stored in the set.
+  *
+  */
+public:
+	static void convexHullJarvisToCH(PointSetView points, string filepath)
+	{
+		ExportToCH::write(points, JarvisAlgo(points), filepath);
+	}
+
+/**
+  *\fn static vector<int> convexHullJarvisIndices(PointSetView points)
+  *\param PointSetView points
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a PointSet
+  *
+  *The indices refer to the positions of the points in the set.
+  *
+  */
+public:
+	static vector<int> convexHullJarvisIndices(PointSetView points)
+	{
+		return JarvisAlgo(points);
+	}
+
 /**
   *\fn pair<vector<int>, vector<Point>> JarvisAlgo(vector<Point> points)
   *\param vector<Point> points
@@ -123,7 +177,7 @@ private:
 			{
 				if(iter == pivotindex)
 					continue;
-				if(checkDirection(pivot, minpoint, points[iter]))
+				if(Orientation::checkDirection(pivot, minpoint, points[iter]))
 				{
 					minpoint = points[iter];
 					minindex = iter;
@@ -138,19 +192,92 @@ private:
 		return {result, points};
 	} 
 
+/**
+  *\fn static vector<int> JarvisAlgo(PointSetView points)
+  *\param PointSetView points
+  *\return vector<int>
+  *
+  *\brief A private function with implementation of Jarvis' March for a PointSetView
+  *
+  *It is the same algorithm as above, working on the indices of the view.
+  *The scan for the point with minimum angle uses the batch orientation test of the Orientation class.
+  *The returned indices refer to the positions in the view.
+  *
+  */
+private:
+	static vector<int> JarvisAlgo(PointSetView points)
+	{
+		/**
+		  *\var double pivotx, pivoty (local)
+		  *\brief The co-ordinates of the pivot, initially located outside the ch
+		  *
+		  *\var int pivotindex (local)
+		  *\brief the index of the point which is currently set as pivot
+		  *
+		  *\var int minindex (local)
+		  *\brief The index of the point with minimum angle encountered till the current loop
+		  *
+		  *\var vector<int> result (local)
+		  *\brief The vector to store the resultant convex hull indices
+		  */
+		int iter;
+		int n = points.size;
+		vector<int> result;						//vector to store the result
+
+		//If the points are less than or equal to three, all of them are in convex hull.
+		if(n <= 3)
+		{
+			for(iter = 0; iter < n; iter++)
+				result.push_back(iter);
+			return result;
+		}
+
+		const double *x = points.x, *y = points.y;
+		double pivotx = x[0], pivoty = y[0];
+		for(iter = 1; iter < n; iter++)
+		{
+			pivotx = min(pivotx, x[iter]);
+			pivoty = min(pivoty, y[iter]);
+		}
+		pivotx -= 1;							//for initializing it outside the ch
+		pivoty -= 1;
+		int pivotindex = -1;
+
+		int minindex;
+		do
+		{
+			minindex = (pivotindex == 0)? 1:0;	//assume that the point is the first point which is not the pivot
+			iter = minindex + 1;
+			//validate our assumption or correct the minindex, a block of points is tested at a time
+			while((iter = Orientation::firstLeft(pivotx, pivoty, x[minindex], y[minindex], x, y, iter, n)) >= 0)
+			{
+				if(iter != pivotindex)
+					minindex = iter;
+				iter++;
+			}
+			result.push_back(minindex);			//insert the point in result
+			pivotx = x[minindex];
+			pivoty = y[minindex];
+			pivotindex = minindex;
+		}
+		while(result.size() < 2 || result[0] != pivotindex); 		//till you encounter the start point
+		result.pop_back();						//last point is repeated twice
+		return result;
+	}
+
 /**
   *\fn getXMin(vector<Point> points)
   *\param vector<Point> points
   *\return the least x co-ordinate
   *
-  *\brief finds the least x co-ordinate and returns it as int
+  *\brief finds the least x co-ordinate
   *
   *
   */
 private:
-	static int getXMin(vector<Point> points)
+	static double getXMin(vector<Point> points)
 	{
-		int xmin = points[0].x;
+		double xmin = points[0].x;
 		for(Point p : points)
 		{
 			if(p.x < xmin)
@@ -164,14 +291,14 @@ private:
   *\param vector<Point> points
   *\return the least y co-ordinate
   *
-  *\brief finds the least y co-ordinate and returns it as int
+  *\brief finds the least y co-ordinate
   *
   *
   */
 private:
-	static int getYMin(vector<Point> points)
+	static double getYMin(vector<Point> points)
 	{
-		int ymin = points[0].y;
+		double ymin = points[0].y;
 		for(Point p : points)
 		{
 			if(p.y < ymin)
@@ -179,27 +306,4 @@ private:
 		}
 		return ymin;
 	}
-
-/**
-  *\fn checkDirection(Point a, Point b, Point c)
-  *\param Point a
-  *\param Point b
-  *\param Point c
-  *\return a boolean indicating the sign of area
-  *
-  *\brief Check the sign of area
-  *
-  *Returns true if the signed area of the triangle abc is positive
-  *else returns false.
-  */
-private:
-	static bool checkDirection(Point a, Point b, Point c)
-	{
-		//compute area * 2
-		double area = a.x * b.y - b.x * a.y + b.x * c.y - c.x * b.y + c.x * a.y - a.x * c.y;
-		if(area > 0.0)
-			return true;
-		return false;
-	}
-	
 };
\ No newline at end of file
@@ -0,0 +1,313 @@
+/**\file: MergeHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Merge convex hulls which are already known into the convex hull of all of them.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The hull of the union of some sets of points is the hull of the corners of their hulls.
+  *The corners of a convex polygon split at its least and its largest corner into two chains which are already sorted by x,
+  *so the corners of two hulls are sorted by merging four sorted chains, in linear time.
+  *The monotone chain of Andrew's Algorithm then takes linear time as well, so two hulls of h1 and h2 corners are merged in O(h1 + h2) time.
+  *Unlike the bridges between two hulls, this works even if the hulls overlap, e.g. for shards of points which are not split by a line.
+  *k hulls are merged in pairs, round after round, in O(hlogk) time for h corners in all.
+  *The corners can be on an integer grid as well, in a BasicPointSetView<int>, then the merge is exact with integer arithmetic.
+  */
+class MergeHull
+{
+/**
+  *\fn static Polygon mergeHulls(Polygon first, Polygon second)
+  *\param Polygon first
+  *\param Polygon second
+  *\return Polygon which is the convex hull of both polygons
+  *
+  *\brief A function to merge two convex hulls in O(h1 + h2) time.
+  *
+  *The corners of each polygon must be in order around it, clockwise or anticlockwise, from any corner.
+  *So the result of any of the hull algorithms can be passed.
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners are kept.
+  *
+  */
+public:
+	static Polygon mergeHulls(Polygon first, Polygon second)
+	{
+		vector<Polygon> hulls;
+		hulls.push_back(first);
+		hulls.push_back(second);
+		return mergeHulls(hulls, 1);
+	}
+
+/**
+  *\fn static Polygon mergeHulls(vector<Polygon> hulls, int threads)
+  *\param vector<Polygon> hulls
+  *\param int threads
+  *\return Polygon which is the convex hull of all the polygons
+  *
+  *\brief A function to merge many convex hulls, e.g. the hulls of the shards of a set of points.
+  *
+  *The polygons are merged in pairs, and the pairs of a round are merged on a WorkStealingPool.
+  *threads is the number of threads of the pool, zero or less means the number of hardware threads and one means no pool.
+  *
+  */
+public:
+	static Polygon mergeHulls(vector<Polygon> hulls, int threads = 0)
+	{
+		PointSet corners(true);
+		vector<int> offsets(1, 0);
+		for(Polygon &polygon : hulls)
+		{
+			for(int iter = 0; iter < polygon.getSize(); iter++)
+				corners.insertAtLast(polygon.getPoint(iter));
+			offsets.push_back(corners.getSize());
+		}
+		Polygon result;									//create a polygon
+		for(int i : mergeHullsIndices(corners.getView(), offsets, threads))
+			result.insertAtLast(corners.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static vector<int> mergeHullsIndices(PointSetView points, int middle)
+  *\param PointSetView points the corners of two convex polygons, one after the other
+  *\param int middle the first polygon is made of the points 0 to middle - 1 and the second one of the rest
+  *\return the indices of the corners of the convex hull of both polygons
+  *
+  *\brief A function to merge two convex hulls stored in a PointSet, without making a Polygon.
+  *
+  */
+public:
+	static vector<int> mergeHullsIndices(PointSetView points, int middle)
+	{
+		return MergePairAlgo(points, middle);
+	}
+
+/**
+  *\fn static vector<int> mergeHullsIndices(PointSetView points, const vector<int> &offsets, int threads)
+  *\param PointSetView points the corners of all the convex polygons, one after the other
+  *\param const vector<int> &offsets polygon c is made of the points offsets[c] to offsets[c + 1] - 1, like the clusters of BatchHull
+  *\param int threads
+  *\return the indices of the corners of the convex hull of all the polygons
+  *
+  *\brief A function to merge many convex hulls stored in a PointSet.
+  *
+  */
+public:
+	static vector<int> mergeHullsIndices(PointSetView points, const vector<int> &offsets, int threads = 0)
+	{
+		return MergeAllAlgo(points, offsets, threads);
+	}
+
+/**
+  *\fn static vector<int> mergeHullsIndices(BasicPointSetView<int> points, int middle)
+  *\param BasicPointSetView<int> points the corners of two convex polygons on an integer grid, one after the other
+  *\param int middle the first polygon is made of the points 0 to middle - 1 and the second one of the rest
+  *\return the indices of the corners of the convex hull of both polygons
+  *
+  *\brief The same merge for points on an integer grid, with the exact integer turn.
+  *
+  */
+public:
+	static vector<int> mergeHullsIndices(BasicPointSetView<int> points, int middle)
+	{
+		return MergePairAlgo(points, middle);
+	}
+
+/**
+  *\fn static vector<int> mergeHullsIndices(BasicPointSetView<int> points, const vector<int> &offsets, int threads)
+  *\param BasicPointSetView<int> points the corners of all the convex polygons on an integer grid, one after the other
+  *\param const vector<int> &offsets polygon c is made of the points offsets[c] to offsets[c + 1] - 1
+  *\param int threads
+  *\return the indices of the corners of the convex hull of all the polygons
+  *
+  *\brief The same merge of many convex hulls for points on an integer grid.
+  *
+  */
+public:
+	static vector<int> mergeHullsIndices(BasicPointSetView<int> points, const vector<int> &offsets, int threads = 0)
+	{
+		return MergeAllAlgo(points, offsets, threads);
+	}
+
+/**
+  *\var static const int MIN_TASK
+  *\brief The least number of corners in all for which the pairs are merged on a pool.
+  */
+private:
+	static const int MIN_TASK = 1 << 14;
+
+/**
+  *\fn template<class T> static vector<int> MergePairAlgo(BasicPointSetView<T> points, int middle)
+  *
+  *\brief Split the indices at middle and merge both hulls, for the public functions with two hulls.
+  */
+private:
+	template<class T>
+	static vector<int> MergePairAlgo(BasicPointSetView<T> points, int middle)
+	{
+		vector<int> first(middle), second(points.size - middle), result;
+		for(int iter = 0; iter < points.size; iter++)
+			(iter < middle ? first[iter] : second[iter - middle]) = iter;
+		MergeAlgo(points, first, second, result);
+		return result;
+	}
+
+/**
+  *\fn template<class T> static vector<int> MergeAllAlgo(BasicPointSetView<T> points, const vector<int> &offsets, int threads)
+  *
+  *\brief Merge the hulls in pairs, round after round, for the public functions with many hulls.
+  */
+private:
+	template<class T>
+	static vector<int> MergeAllAlgo(BasicPointSetView<T> points, const vector<int> &offsets, int threads)
+	{
+		int k = (int)offsets.size() - 1;
+		vector<vector<int> > hulls(max(k, 1));
+		for(int c = 0; c < k; c++)
+			for(int iter = offsets[c]; iter < offsets[c + 1]; iter++)
+				hulls[c].push_back(iter);
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		unique_ptr<WorkStealingPool> pool;
+		if(threads > 1 && k > 2 && points.size >= 2 * MIN_TASK)
+			pool.reset(new WorkStealingPool(threads));
+
+		if(hulls.size() == 1)					//a single hull is still started at its least corner
+			hulls.push_back(vector<int>());
+		while(hulls.size() > 1)
+		{
+			int pairs = hulls.size() / 2;
+			vector<vector<int> > merged((hulls.size() + 1) / 2);
+			auto task = [&](int p) { MergeAlgo(points, hulls[2 * p], hulls[2 * p + 1], merged[p]); };
+			if(pool && pairs > 1)
+			{
+				WorkStealingPool::Group group;
+				for(int p = 0; p < pairs; p++)
+					pool->run(group, [&task, p]() { task(p); });
+				pool->wait(group);
+			}
+			else
+				for(int p = 0; p < pairs; p++)
+					task(p);
+			if(hulls.size() % 2 == 1)
+				merged.back().swap(hulls.back());
+			hulls.swap(merged);
+		}
+		return hulls[0];
+	}
+
+/**
+  *\fn template<class T> static void MergeAlgo(BasicPointSetView<T> points, const vector<int> &first, const vector<int> &second, vector<int> &result)
+  *\param PointSetView points
+  *\param const vector<int> &first, &second the indices of the corners of two convex polygons, in order around them
+  *\param vector<int> &result the indices of the corners of the hull of both, clockwise from the least one
+  *
+  *\brief The monotone chain, the upper chain from left to right and then the lower chain back, on the merged corners.
+  *
+  *A point is removed from the chain unless it makes a clockwise turn, so points in the middle of an edge and repeated points are dropped.
+  */
+private:
+	template<class T>
+	static void MergeAlgo(BasicPointSetView<T> points, const vector<int> &first, const vector<int> &second, vector<int> &result)
+	{
+		const T *x = points.x, *y = points.y;
+		auto less = [x, y](int A, int B) {
+			return x[A] < x[B] || (x[A] == x[B] && y[A] < y[B]);
+		};
+		vector<int> a, b, sorted(first.size() + second.size());
+		sortedCorners(points, first, a);
+		sortedCorners(points, second, b);
+		merge(a.begin(), a.end(), b.begin(), b.end(), sorted.begin(), less);
+
+		int n = sorted.size();
+		result.clear();
+		if(n == 0)
+			return;
+		if(x[sorted[0]] == x[sorted[n - 1]] && y[sorted[0]] == y[sorted[n - 1]])
+		{
+			result.push_back(sorted[0]);		//all the points are the same
+			return;
+		}
+		vector<int> &chain = result;
+		int k = 0;
+		chain.resize(2 * n);
+		for(int iter = 0; iter < n; iter++)		//upper chain
+		{
+			while(k >= 2 && turn(points, chain[k - 2], chain[k - 1], sorted[iter]) >= 0)
+				k--;
+			chain[k++] = sorted[iter];
+		}
+		for(int iter = n - 2, upper = k + 1; iter >= 0; iter--)	//lower chain
+		{
+			while(k >= upper && turn(points, chain[k - 2], chain[k - 1], sorted[iter]) >= 0)
+				k--;
+			chain[k++] = sorted[iter];
+		}
+		chain.resize(k - 1);					//the least point is at both ends
+	}
+
+/**
+  *\fn template<class T> static void sortedCorners(BasicPointSetView<T> points, const vector<int> &corners, vector<int> &sorted)
+  *\param const vector<int> &corners the corners of a convex polygon in order around it
+  *\param vector<int> &sorted the corners sorted by x and then by y
+  *
+  *\brief Sort the corners of a convex polygon in linear time.
+  *
+  *Both chains from the least to the largest corner are sorted, so they are merged.
+  */
+private:
+	template<class T>
+	static void sortedCorners(BasicPointSetView<T> points, const vector<int> &corners, vector<int> &sorted)
+	{
+		const T *x = points.x, *y = points.y;
+		auto less = [x, y](int A, int B) {
+			return x[A] < x[B] || (x[A] == x[B] && y[A] < y[B]);
+		};
+		int h = corners.size(), least = 0, largest = 0;
+		sorted.clear();
+		if(h == 0)
+			return;
+		for(int iter = 1; iter < h; iter++)
+		{
+			if(less(corners[iter], corners[least]))
+				least = iter;
+			if(less(corners[largest], corners[iter]))
+				largest = iter;
+		}
+		vector<int> forward, backward;
+		for(int iter = least; ; iter = (iter + 1) % h)
+		{
+			forward.push_back(corners[iter]);
+			if(iter == largest)
+				break;
+		}
+		for(int iter = (least + h - 1) % h; iter != largest; iter = (iter + h - 1) % h)
+			backward.push_back(corners[iter]);
+		sorted.resize(h);
+		merge(forward.begin(), forward.end(), backward.begin(), backward.end(), sorted.begin(), less);
+	}
+
+/**
+  *\fn static double turn(PointSetView &points, int a, int b, int c)
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  */
+private:
+	static double turn(PointSetView &points, int a, int b, int c)
+	{
+		const double *x = points.x, *y = points.y;
+		return Orientation::turn(x[a], y[a], x[b], y[b], x[c], y[c]);
+	}
+
+/**
+  *\fn static int turn(BasicPointSetView<int> &points, int a, int b, int c)
+  *\return the sign of the area of the triangle abc, with the exact integer turn
+  */
+private:
+	static int turn(BasicPointSetView<int> &points, int a, int b, int c)
+	{
+		const int *x = points.x, *y = points.y;
+		return Orientation::turn(x[a], y[a], x[b], y[b], x[c], y[c]);
+	}
+};
@@ -0,0 +1,437 @@
+/**\file: QuickHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Get convex hull of a given set of points with QuickHull
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The class provides a static function to get a convex hull of given set of points.
+  *QuickHull is used to find the convex hull.
+  *The least and the greatest point split the points into the ones above and the ones below the line joining them.
+  *For every side the point farthest from the line is on the hull, and the points outside the two new edges are processed the same way.
+  *The points inside the triangle are dropped, so there is no sort of all the points.
+  *The two halves of every step are tasks of a WorkStealingPool, so the work spreads over the threads even when the hull is skewed.
+  *The time complexity of the algorithm is O(nlogh) on average and O(nh) in the worst case.
+  *The user can also export the function to .ch format, as required by the assignment.
+  *For indepth description, plese see the individual function description.
+  */
+class QuickHull
+{
+/**
+  *\fn static Polygon convexHullQuick(vector<Point> points, int threads)
+  *\param vector<Point> points
+  *\param int threads
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull with QuickHull
+  *
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners of the hull are returned, the points in the middle of an edge are not.
+  *threads is the number of threads of the pool, zero or less means the number of hardware threads and one means no pool.
+  *It returns a Polygon class. Refer to documentation of the class for details.
+  *
+  */
+public:
+	static Polygon convexHullQuick(vector<Point> points, int threads = 0)
+	{
+		PointSet set(points);
+		vector<int> ch = QuickAlgo(set.getView(), threads);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points[i]);				//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullQuickToCH(vector<Point> points, string filepath, int threads)
+  *\param vector<Point> points
+  *\param string filepath
+  *\param int threads
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull
+  *
+  *The function takes a vector of points and a file path as parameters.
+  *The convex hull of given set of points is calculated and saved as .ch file at the given filepath.
+  *QuickHull is used for finding the convex hull.
+  *The points are written in the order they were given and the indices refer to that order.
+  *For details on .ch file, contact Dr. T Ray from BITS Pilani University.
+  *
+  */
+public:
+	static void convexHullQuickToCH(vector<Point> points, string filepath, int threads = 0)
+	{
+		PointSet set(points);
+		ExportToCH::write(points, QuickAlgo(set.getView(), threads), filepath);
+	}
+
+/**
+  *\fn static Polygon convexHullQuick(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return Polygon which is the convex hull of the given set of points
+  *
+  *\brief A function to get convex hull of a PointSet with QuickHull
+  *
+  *The points are not copied and the z co-ordinates are never read.
+  *
+  */
+public:
+	static Polygon convexHullQuick(PointSetView points, int threads = 0)
+	{
+		vector<int> ch = QuickAlgo(points, threads);
+		Polygon result;									//create a polygon
+		for(int i : ch)
+			result.insertAtLast(points.getPoint(i));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static void convexHullQuickToCH(PointSetView points, string filepath, int threads)
+  *\param PointSetView points
+  *\param string filepath
+  *\param int threads
+  *\return void
+  *
+  *\brief A function to get .ch file of Convex hull of a PointSet
+  *
+  *The points are written in the order they are stored in the set.
+  *
+  */
+public:
+	static void convexHullQuickToCH(PointSetView points, string filepath, int threads = 0)
+	{
+		ExportToCH::write(points, QuickAlgo(points, threads), filepath);
+	}
+
+/**
+  *\fn static vector<int> convexHullQuickIndices(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return the indices of the points on the convex hull
+  *
+  *\brief A function to get the indices of the convex hull points of a PointSet
+  *
+  *The indices refer to the positions of the points in the set.
+  *
+  */
+public:
+	static vector<int> convexHullQuickIndices(PointSetView points, int threads = 0)
+	{
+		return QuickAlgo(points, threads);
+	}
+
+/**
+  *\fn static vector<int> convexHullQuickIndices(PointSetView points, WorkStealingPool &pool)
+  *\param PointSetView points
+  *\param WorkStealingPool &pool
+  *\return the indices of the points on the convex hull
+  *
+  *\brief The same as above, with the tasks run on a pool of the caller
+  *
+  *Useful when many hulls are found one after another, the threads are started only once.
+  *
+  */
+public:
+	static vector<int> convexHullQuickIndices(PointSetView points, WorkStealingPool &pool)
+	{
+		return QuickAlgo(points, &pool);
+	}
+
+/**
+  *\fn static vector<int> QuickAlgo(PointSetView points, int threads)
+  *\param PointSetView points
+  *\param int threads
+  *\return vector<int>
+  *
+  *\brief Start a pool with the given number of threads, if more than one, and run QuickHull on it.
+  *
+  */
+private:
+	static vector<int> QuickAlgo(PointSetView points, int threads)
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || points.size < MIN_TASK)
+			return QuickAlgo(points, (WorkStealingPool *)NULL);
+		WorkStealingPool pool(threads);
+		return QuickAlgo(points, &pool);
+	}
+
+/**
+  *\fn static vector<int> QuickAlgo(PointSetView points, WorkStealingPool *pool)
+  *\param PointSetView points
+  *\param WorkStealingPool *pool NULL to run everything on the calling thread
+  *\return vector<int>
+  *
+  *\brief A private function with implementation of QuickHull
+  *
+  *The indices of the points above the line from the least to the greatest point are put at the front of a buffer,
+  *and the ones below it right after them.
+  *Every step then works on its own range of the buffer, so the steps can run at the same time.
+  *Large ranges are scanned in chunks by the pool as well, so the first steps do not hold up the others.
+  *The returned indices refer to the positions in the view.
+  *
+  */
+private:
+	static vector<int> QuickAlgo(PointSetView points, WorkStealingPool *pool)
+	{
+		/**
+		  *\var int least, greatest (local)
+		  *\brief The least and the greatest point, by x and then by y. Both are on the hull.
+		  *
+		  *\var vector<int> buffer (local)
+		  *\brief The indices of the points which are still outside the hull found so far.
+		  *
+		  *\var vector<int> result (local)
+		  *\brief The vector to store the resultant convex hull indices
+		  */
+		int n = points.size;
+		const double *x = points.x, *y = points.y;
+		vector<int> result;
+		if(n == 0)
+			return result;
+
+		vector<int> buffer(n);
+		int chunks = chunksFor(n, pool);
+		vector<int> leasts(chunks), greatests(chunks);
+		forEachChunk(n, chunks, pool, [&](int chunk, int begin, int end) {
+			int least = begin, greatest = begin;
+			for(int i = begin; i < end; i++)
+			{
+				buffer[i] = i;
+				if(x[i] < x[least] || (x[i] == x[least] && y[i] < y[least]))
+					least = i;
+				if(x[i] > x[greatest] || (x[i] == x[greatest] && y[i] > y[greatest]))
+					greatest = i;
+			}
+			leasts[chunk] = least;
+			greatests[chunk] = greatest;
+		});
+		int least = leasts[0], greatest = greatests[0];
+		for(int chunk = 1; chunk < chunks; chunk++)
+		{
+			int i = leasts[chunk], j = greatests[chunk];
+			if(x[i] < x[least] || (x[i] == x[least] && y[i] < y[least]))
+				least = i;
+			if(x[j] > x[greatest] || (x[j] == x[greatest] && y[j] > y[greatest]))
+				greatest = j;
+		}
+		result.push_back(least);
+		if(x[least] == x[greatest] && y[least] == y[greatest])
+			return result;						//all the points are the same
+
+		int above, below;
+		split(points, least, greatest, greatest, least, buffer.data(), n, pool, above, below);
+
+		vector<int> upper, lower;
+		if(pool)
+		{
+			WorkStealingPool::Group group;
+			pool->run(group, [&]() { upper = expand(points, least, greatest, buffer.data(), above, pool); });
+			lower = expand(points, greatest, least, buffer.data() + above, below, pool);
+			pool->wait(group);
+		}
+		else
+		{
+			upper = expand(points, least, greatest, buffer.data(), above, NULL);
+			lower = expand(points, greatest, least, buffer.data() + above, below, NULL);
+		}
+
+		result.insert(result.end(), upper.begin(), upper.end());
+		result.push_back(greatest);
+		result.insert(result.end(), lower.begin(), lower.end());
+		return result;
+	}
+
+/**
+  *\fn static vector<int> expand(PointSetView &points, int a, int b, int *outside, int count, WorkStealingPool *pool)
+  *\param PointSetView &points
+  *\param int a, b an edge of the hull found so far
+  *\param int *outside the points on the left of a to b, which is outside the hull
+  *\param int count the number of such points
+  *\param WorkStealingPool *pool
+  *\return the corners of the hull between a and b, in order from a to b
+  *
+  *\brief A single step of QuickHull
+  *
+  *The farthest point c from the edge is found, it is a corner of the hull.
+  *The points outside the edge a to c are moved to the front of outside, the ones outside c to b right after them, and the rest are dropped.
+  *Both ranges are expanded recursively, the first one as a task if both have enough points.
+  *If two points are the farthest, the one nearer to b is taken, so that the other one is outside a to c and c is a corner.
+  */
+private:
+	static vector<int> expand(PointSetView &points, int a, int b, int *outside, int count, WorkStealingPool *pool)
+	{
+		vector<int> result;
+		if(count == 0)
+			return result;
+		const double *x = points.x, *y = points.y;
+		double ax = x[a], ay = y[a], bx = x[b], by = y[b];
+
+		auto farther = [&](int i, double area, int c, double farthest) {
+			return area > farthest || (area == farthest && (bx - ax) * (x[i] - x[c]) + (by - ay) * (y[i] - y[c]) > 0);
+		};
+		int chunks = chunksFor(count, pool);
+		vector<int> candidates(chunks);
+		forEachChunk(count, chunks, pool, [&](int chunk, int begin, int end) {
+			int c = outside[begin];
+			double farthest = turn(ax, ay, bx, by, x[c], y[c]);
+			for(int i = begin + 1; i < end; i++)
+			{
+				int j = outside[i];
+				double area = turn(ax, ay, bx, by, x[j], y[j]);
+				if(farther(j, area, c, farthest))
+				{
+					farthest = area;
+					c = j;
+				}
+			}
+			candidates[chunk] = c;
+		});
+		int c = candidates[0];
+		for(int chunk = 1; chunk < chunks; chunk++)
+		{
+			int j = candidates[chunk];
+			if(farther(j, turn(ax, ay, bx, by, x[j], y[j]), c, turn(ax, ay, bx, by, x[c], y[c])))
+				c = j;
+		}
+
+		int first, second;
+		split(points, a, c, c, b, outside, count, pool, first, second);
+
+		vector<int> left, right;
+		if(pool && first >= MIN_TASK && second >= MIN_TASK)
+		{
+			WorkStealingPool::Group group;
+			pool->run(group, [&]() { left = expand(points, a, c, outside, first, pool); });
+			right = expand(points, c, b, outside + first, second, pool);
+			pool->wait(group);
+		}
+		else
+		{
+			left = expand(points, a, c, outside, first, pool);
+			right = expand(points, c, b, outside + first, second, pool);
+		}
+
+		result.swap(left);
+		result.push_back(c);
+		result.insert(result.end(), right.begin(), right.end());
+		return result;
+	}
+
+/**
+  *\fn static void split(PointSetView &points, int a, int b, int c, int d, int *outside, int count, WorkStealingPool *pool, int &first, int &second)
+  *\param PointSetView &points
+  *\param int a, b the first edge
+  *\param int c, d the second edge
+  *\param int *outside, int count the points to split
+  *\param WorkStealingPool *pool
+  *\param int &first, &second to store the number of points on the left of each edge
+  *
+  *\brief Move the points on the left of a to b to the front of outside, the ones on the left of c to d right after them, and drop the rest.
+  *
+  *Every chunk first moves the points it keeps to its front and then splits them with std::partition, all in place.
+  *With more than one chunk, the parts of the chunks are gathered through a buffer of the kept points only.
+  */
+private:
+	static void split(PointSetView &points, int a, int b, int c, int d, int *outside, int count, WorkStealingPool *pool, int &first, int &second)
+	{
+		const double *x = points.x, *y = points.y;
+		double ax = x[a], ay = y[a], bx = x[b], by = y[b], cx = x[c], cy = y[c], dx = x[d], dy = y[d];
+		auto leftOfFirst = [&](int j) {
+			return turn(ax, ay, bx, by, x[j], y[j]) > 0;
+		};
+
+		int chunks = chunksFor(count, pool);
+		vector<int> front(chunks), kept(chunks);
+		forEachChunk(count, chunks, pool, [&](int chunk, int begin, int end) {
+			int k = begin;
+			for(int i = begin; i < end; i++)
+			{
+				int j = outside[i];
+				outside[k] = j;
+				k += (leftOfFirst(j) || turn(cx, cy, dx, dy, x[j], y[j]) > 0);
+			}
+			front[chunk] = partition(outside + begin, outside + k, leftOfFirst) - (outside + begin);
+			kept[chunk] = k - begin;
+		});
+
+		first = second = 0;
+		vector<int> firstAt(chunks), secondAt(chunks);
+		for(int chunk = 0; chunk < chunks; chunk++)
+		{
+			firstAt[chunk] = first;
+			secondAt[chunk] = second;
+			first += front[chunk];
+			second += kept[chunk] - front[chunk];
+		}
+		if(chunks == 1)
+			return;
+
+		vector<int> gathered(first + second);
+		forEachChunk(count, chunks, pool, [&](int chunk, int begin, int) {
+			copy(outside + begin, outside + begin + front[chunk], gathered.begin() + firstAt[chunk]);
+			copy(outside + begin + front[chunk], outside + begin + kept[chunk], gathered.begin() + first + secondAt[chunk]);
+		});
+		copy(gathered.begin(), gathered.end(), outside);
+	}
+
+/**
+  *\fn static int chunksFor(int count, WorkStealingPool *pool)
+  *\return the number of chunks a scan over count points is split into, one if it is not worth it
+  */
+private:
+	static int chunksFor(int count, WorkStealingPool *pool)
+	{
+		if(!pool || count < 2 * MIN_TASK)
+			return 1;
+		return min(4 * pool->getSize(), count / MIN_TASK);
+	}
+
+/**
+  *\fn static void forEachChunk(int count, int chunks, WorkStealingPool *pool, const function<void(int, int, int)> &call)
+  *\param int count, int chunks
+  *\param WorkStealingPool *pool
+  *\param const function<void(int, int, int)> &call called with the chunk, its begin and its end
+  *
+  *\brief Split the range 0 to count into chunks of about the same size and call call for each of them, as tasks of the pool.
+  */
+private:
+	static void forEachChunk(int count, int chunks, WorkStealingPool *pool, const function<void(int, int, int)> &call)
+	{
+		if(chunks == 1)
+		{
+			call(0, 0, count);
+			return;
+		}
+		WorkStealingPool::Group group;
+		for(int chunk = 0; chunk < chunks; chunk++)
+			pool->run(group, [&call, chunk, count, chunks]() {
+				call(chunk, (long long)count * chunk / chunks, (long long)count * (chunk + 1) / chunks);
+			});
+		pool->wait(group);
+	}
+
+/**
+  *\var static const int MIN_TASK
+  *\brief The least number of points for which a step or a chunk is given to the pool, smaller ones are done right away.
+  */
+private:
+	static const int MIN_TASK = 1 << 12;
+
+/**
+  *\fn static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+  *\param double ax, ay, bx, by, cx, cy
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  *
+  *\brief The orientation test used by QuickHull, Orientation::turn like the one of Chan's Algorithm.
+  */
+private:
+	static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return Orientation::turn(ax, ay, bx, by, cx, cy);
+	}
+};
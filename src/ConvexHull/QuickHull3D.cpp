@@ -0,0 +1,603 @@
+/**\file: QuickHull3D.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Get convex hull of a given set of points in 3D with QuickHull
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The class provides a static function to get the convex hull of given set of points in 3D, using the z co-ordinates.
+  *The hull is a set of triangular facets, see the Facet class.
+  *It starts with a tetrahedron of four extreme points.
+  *Every point outside the hull is kept in the outside set of exactly one facet it is above, which is the conflict graph.
+  *Then the farthest point of a facet is added: the facets it can see are removed
+  *and the edges on the border of the removed region, the horizon, are joined to the point with new facets.
+  *The points of the removed facets are given to the new facets or dropped if they are inside now.
+  *The expected time complexity is O(nlogn), points inside the hull are dropped early and cost little.
+  *The user can also export the facets to the .ch format extended for 3D, see ExportToCH.
+  *For indepth description, plese see the individual function description.
+  */
+class QuickHull3D
+{
+/**
+  *\fn static vector<Facet> convexHull3D(vector<Point> points)
+  *\param vector<Point> points
+  *\return the facets of the convex hull, with the indices of the points
+  *
+  *\brief A function to get the convex hull in 3D with QuickHull
+  *
+  *The corners of every facet are in anti-clockwise order as seen from outside.
+  *Faces of the hull with more than three corners are split into triangles.
+  *If all the points are on one plane there is no solid hull and no facets are returned.
+  *
+  */
+public:
+	static vector<Facet> convexHull3D(vector<Point> points)
+	{
+		PointSet set(points, true);
+		return QuickHull3DAlgo(set.getView());
+	}
+
+/**
+  *\fn static void convexHull3DToCH(vector<Point> points, string filepath)
+  *\param vector<Point> points
+  *\param string filepath
+  *\return void
+  *
+  *\brief A function to get .ch file of the convex hull in 3D
+  *
+  *The points are written in the order they were given, followed by the facets.
+  *
+  */
+public:
+	static void convexHull3DToCH(vector<Point> points, string filepath)
+	{
+		PointSet set(points, true);
+		ExportToCH::write(points, QuickHull3DAlgo(set.getView()), filepath);
+	}
+
+/**
+  *\fn static vector<Facet> convexHull3D(PointSetView points)
+  *\param PointSetView points
+  *\return the facets of the convex hull, with the indices of the points in the view
+  *
+  *\brief A function to get the convex hull in 3D of a PointSet
+  *
+  *The view must have z co-ordinates, otherwise all the points are on one plane and there are no facets.
+  *
+  */
+public:
+	static vector<Facet> convexHull3D(PointSetView points)
+	{
+		return QuickHull3DAlgo(points);
+	}
+
+/**
+  *\fn static void convexHull3DToCH(PointSetView points, string filepath)
+  *\param PointSetView points
+  *\param string filepath
+  *\return void
+  *
+  *\brief A function to get .ch file of the convex hull in 3D of a PointSet
+  *
+  */
+public:
+	static void convexHull3DToCH(PointSetView points, string filepath)
+	{
+		ExportToCH::write(points, QuickHull3DAlgo(points), filepath);
+	}
+
+/**
+  *\var struct Face
+  *\brief A facet of the hull while it is being built.
+  *
+  *Edge i runs from vertex[i] to vertex[(i + 1) % 3] and neighbour[i] is the facet on the other side of it.
+  *The plane is stored as a unit normal and an offset, so distance() is the distance of a point above the plane.
+  *outside holds the points which are above this facet and not given to any other one, farthest is the farthest of them.
+  */
+private:
+	struct Face
+	{
+		int vertex[3], neighbour[3];
+		double nx, ny, nz, offset;
+		vector<int> outside;
+		int farthest;
+		double height;
+		int visited;
+		bool alive;
+	};
+
+/**
+  *\fn static vector<Facet> QuickHull3DAlgo(PointSetView points)
+  *\param PointSetView points
+  *\return vector<Facet>
+  *
+  *\brief A private function with implementation of QuickHull in 3D
+  *
+  *A point is only taken as above a facet if it is farther than a small tolerance, relative to the size of the co-ordinates.
+  *This keeps the facets consistent when points are on or very near a plane of the hull, like the corners of a grid.
+  *A facet on the plane of the added point is removed with the visible ones if keeping it would leave a new facet turned over
+  *or bent inwards against it, see isVisible, so nearly flat parts of the hull never get facets facing the wrong way.
+  *The returned indices refer to the positions in the view.
+  *
+  */
+private:
+	static vector<Facet> QuickHull3DAlgo(PointSetView points)
+	{
+		/**
+		  *\var vector<Face> faces (local)
+		  *\brief The facets, the removed ones are marked as not alive.
+		  *
+		  *\var vector<int> unused (local)
+		  *\brief The removed facets, their places are taken by the facets made in the next steps.
+		  *
+		  *\var vector<int> pending (local)
+		  *\brief The facets which may still have points outside.
+		  *
+		  *\var vector<int> startOf (local)
+		  *\brief For every point, the new facet whose horizon edge starts at it, -1 otherwise.
+		  *
+		  *\var vector<int> ring, vector<double> wedges, vector<bool> after (local)
+		  *\brief The new facets in their order around the eye, see setWedges.
+		  *
+		  *\var double centre[3] (local)
+		  *\brief The centre of the tetrahedron, which is inside the hull at every step.
+		  */
+		int iter, n = points.size;
+		vector<Facet> result;
+		if(n < 4 || !points.z)
+			return result;
+		const double *x = points.x, *y = points.y, *z = points.z;
+
+		double scale = 0;
+		for(iter = 0; iter < n; iter++)
+			scale = max(scale, max(fabs(x[iter]), max(fabs(y[iter]), fabs(z[iter]))));
+		double tolerance = scale * TOLERANCE;
+
+		int corner[4];
+		if(!tetrahedron(points, tolerance, corner))
+			return result;						//all the points are on one plane
+
+		double centre[3] = {0, 0, 0};
+		for(iter = 0; iter < 4; iter++)
+		{
+			centre[0] += x[corner[iter]] / 4;
+			centre[1] += y[corner[iter]] / 4;
+			centre[2] += z[corner[iter]] / 4;
+		}
+
+		vector<Face> faces;
+		int sides[4][3] = {{0, 1, 2}, {0, 3, 1}, {1, 3, 2}, {2, 3, 0}};
+		for(iter = 0; iter < 4; iter++)
+			faces.push_back(makeFace(points, corner[sides[iter][0]], corner[sides[iter][1]], corner[sides[iter][2]]));
+		for(int f = 0; f < 4; f++)				//join the facets of the tetrahedron
+			for(int e = 0; e < 3; e++)
+				for(int g = 0; g < 4; g++)
+					for(int h = 0; h < 3; h++)
+						if(faces[f].vertex[e] == faces[g].vertex[(h + 1) % 3] && faces[f].vertex[(e + 1) % 3] == faces[g].vertex[h])
+							faces[f].neighbour[e] = g;
+
+		for(iter = 0; iter < n; iter++)
+		{
+			if(iter == corner[0] || iter == corner[1] || iter == corner[2] || iter == corner[3])
+				continue;
+			for(int f = 0; f < 4; f++)
+				if(assign(points, faces[f], iter, tolerance))
+					break;
+		}
+
+		vector<int> pending = {0, 1, 2, 3}, startOf(n, -1), visible, created, ring, orphans, unused;
+		vector<double> wedges;
+		vector<bool> after;
+		vector<pair<int, int>> horizon;
+		int stamp = 0;
+		while(!pending.empty())
+		{
+			int f = pending.back();
+			pending.pop_back();
+			if(!faces[f].alive || faces[f].outside.empty())
+				continue;
+			int eye = faces[f].farthest;
+
+			//find the facets the eye can see, or has to replace as it is on their plane, and the horizon around them
+			stamp++;
+			visible.assign(1, f);
+			horizon.clear();
+			faces[f].visited = stamp;
+			for(int k = 0; k < (int)visible.size(); k++)
+			{
+				Face &face = faces[visible[k]];
+				for(int e = 0; e < 3; e++)
+				{
+					int g = face.neighbour[e];
+					if(faces[g].visited == stamp)
+						continue;
+					if(isVisible(points, faces[g], face.vertex[e], face.vertex[(e + 1) % 3], eye, tolerance))
+					{
+						faces[g].visited = stamp;
+						visible.push_back(g);
+					}
+					else
+						horizon.push_back(make_pair(visible[k], e));
+				}
+			}
+
+			//a horizon which is not a single cycle only comes from rounding, the eye is then taken as on the hull
+			if(!isCycle(faces, horizon, startOf))
+			{
+				drop(points, faces[f], eye, tolerance);
+				pending.push_back(f);
+				continue;
+			}
+
+			//join every horizon edge to the eye, the new facets are linked to each other through startOf
+			created.clear();
+			for(pair<int, int> edge : horizon)
+			{
+				int u = faces[edge.first].vertex[edge.second], v = faces[edge.first].vertex[(edge.second + 1) % 3];
+				int g = faces[edge.first].neighbour[edge.second];
+				int id = faces.size();
+				if(unused.empty())
+					faces.push_back(makeFace(points, u, v, eye));
+				else
+				{
+					id = unused.back();
+					unused.pop_back();
+					faces[id] = makeFace(points, u, v, eye);
+				}
+				faces[id].neighbour[0] = g;
+				for(int h = 0; h < 3; h++)
+					if(faces[g].vertex[h] == v && faces[g].vertex[(h + 1) % 3] == u)
+						faces[g].neighbour[h] = id;
+				startOf[u] = id;
+				created.push_back(id);
+			}
+			for(int id : created)
+			{
+				int next = startOf[faces[id].vertex[1]];
+				faces[id].neighbour[1] = next;
+				faces[next].neighbour[2] = id;
+			}
+			for(int id : created)
+				startOf[faces[id].vertex[0]] = -1;
+
+			//give the points of the removed facets to the new ones
+			orphans.clear();
+			for(int v : visible)
+			{
+				faces[v].alive = false;
+				for(int p : faces[v].outside)
+					if(p != eye)
+						orphans.push_back(p);
+				vector<int>().swap(faces[v].outside);
+				unused.push_back(v);
+			}
+			if((int)created.size() <= MIN_RING)
+			{
+				for(int p : orphans)
+					for(int id : created)
+						if(assign(points, faces[id], p, tolerance))
+							break;
+			}
+			else
+			{
+				ring.assign(1, created[0]);			//the new facets in their order around the eye, see locate
+				while(ring.size() < created.size())
+					ring.push_back(faces[ring.back()].neighbour[1]);
+				setWedges(points, faces, ring, wedges, after, eye, centre);
+				for(int p : orphans)
+					assign(points, faces[locate(points, ring, wedges, after, p, eye)], p, tolerance);
+			}
+			for(int id : created)
+				if(!faces[id].outside.empty())
+					pending.push_back(id);
+		}
+
+		for(Face &face : faces)
+			if(face.alive)
+				result.push_back(Facet(face.vertex[0], face.vertex[1], face.vertex[2]));
+		return result;
+	}
+
+/**
+  *\fn static bool isVisible(PointSetView &points, Face &face, int u, int v, int eye, double tolerance)
+  *\param Face &face the facet on the other side of the edge from u to v of a visible facet
+  *\param int eye the point which is added
+  *\return true if the facet has to be removed with the visible ones
+  *
+  *\brief Check if the eye sees the facet, or is on its plane so that the new facet on the edge would turn over or bend inwards
+  *
+  *A facet on the plane of the eye, within the tolerance, is kept if the new facet from the edge to the eye faces the same way
+  *and its third corner is not above the new facet, i.e. the edge between them does not bend inwards.
+  *Otherwise the new facet would be turned over, or a sliver whose plane has points far beyond the edge above it,
+  *so the facet is removed and the new facets are joined to its other edges.
+  */
+private:
+	static bool isVisible(PointSetView &points, Face &face, int u, int v, int eye, double tolerance)
+	{
+		double height = distance(face, points.x[eye], points.y[eye], points.z[eye]);
+		if(height > tolerance)
+			return true;
+		if(height < -tolerance)
+			return false;
+		Face created = makeFace(points, u, v, eye);
+		int q = face.vertex[0] + face.vertex[1] + face.vertex[2] - u - v;
+		if(created.nx * face.nx + created.ny * face.ny + created.nz * face.nz <= 0)
+			return true;
+		return distance(created, points.x[q], points.y[q], points.z[q]) > tolerance;
+	}
+
+/**
+  *\fn static bool isCycle(vector<Face> &faces, vector<pair<int, int>> &horizon, vector<int> &startOf)
+  *\param vector<Face> &faces
+  *\param vector<pair<int, int>> &horizon the edges of the horizon, as a visible facet and the number of its edge
+  *\param vector<int> &startOf all -1, it is used to find the edges and is all -1 again on return
+  *\return true if the edges form a single cycle
+  *
+  *\brief Check that the new facets can be linked in a ring around the eye
+  *
+  *Every point may start at most one edge, and following the edges from the first one has to visit all of them.
+  *Otherwise the visible facets are not a disk, which happens only when the tolerance decides differently for neighbouring facets.
+  */
+private:
+	static bool isCycle(vector<Face> &faces, vector<pair<int, int>> &horizon, vector<int> &startOf)
+	{
+		int k, size = horizon.size();
+		bool simple = true;
+		for(k = 0; k < size && simple; k++)
+		{
+			int u = faces[horizon[k].first].vertex[horizon[k].second];
+			if(startOf[u] != -1)
+				simple = false;
+			else
+				startOf[u] = k;
+		}
+		int steps = 0;
+		for(k = 0; simple && steps < size; steps++)
+		{
+			k = startOf[faces[horizon[k].first].vertex[(horizon[k].second + 1) % 3]];
+			if(k < 0 || (k == 0 && steps < size - 1))
+				simple = false;
+		}
+		for(pair<int, int> edge : horizon)
+			startOf[faces[edge.first].vertex[edge.second]] = -1;
+		return simple && k == 0;
+	}
+
+/**
+  *\fn static void drop(PointSetView &points, Face &face, int p, double tolerance)
+  *
+  *\brief Remove the point p from the outside set of the facet and find the farthest of the rest again.
+  */
+private:
+	static void drop(PointSetView &points, Face &face, int p, double tolerance)
+	{
+		vector<int> outside;
+		outside.swap(face.outside);
+		face.farthest = -1;
+		face.height = 0;
+		for(int q : outside)
+			if(q != p)
+				assign(points, face, q, tolerance);
+	}
+
+/**
+  *\fn static void setWedges(PointSetView &points, vector<Face> &faces, vector<int> &ring, vector<double> &wedges, vector<bool> &after, int eye, const double centre[3])
+  *\param vector<int> &ring the new facets in their order around the eye
+  *\param vector<double> &wedges for every facet of the ring, the normal of the half plane from the line through the eye and the centre to its first corner
+  *\param vector<bool> &after for every facet of the ring, if that half plane is more than half a turn after the one of ring[0]
+  */
+private:
+	static void setWedges(PointSetView &points, vector<Face> &faces, vector<int> &ring, vector<double> &wedges, vector<bool> &after, int eye, const double centre[3])
+	{
+		const double *x = points.x, *y = points.y, *z = points.z;
+		double ax = centre[0] - x[eye], ay = centre[1] - y[eye], az = centre[2] - z[eye];
+		int size = ring.size();
+		wedges.resize(3 * size);
+		after.assign(size, false);
+		for(int k = 0; k < size; k++)
+		{
+			int q = faces[ring[k]].vertex[0];
+			double qx = x[q] - x[eye], qy = y[q] - y[eye], qz = z[q] - z[eye];
+			wedges[3 * k] = ay * qz - az * qy;
+			wedges[3 * k + 1] = az * qx - ax * qz;
+			wedges[3 * k + 2] = ax * qy - ay * qx;
+			after[k] = wedges[0] * qx + wedges[1] * qy + wedges[2] * qz > 0;
+		}
+	}
+
+/**
+  *\fn static int locate(PointSetView &points, vector<int> &ring, vector<double> &wedges, vector<bool> &after, int p, int eye)
+  *\param vector<int> &ring, vector<double> &wedges, vector<bool> &after see setWedges
+  *\param int p the point
+  *\param int eye the point the new facets are joined to
+  *\return the new facet p has to be above to be outside the hull
+  *
+  *\brief Find the new facet whose wedge holds p with a binary search around the eye.
+  *
+  *The half planes from the line through the eye and a point inside the hull to the corners of the horizon split the space into wedges,
+  *one for every new facet, in the order of the ring. Inside the wedge of a facet, a point is outside the new facets only if it is above that facet.
+  *So a point is tested against O(log) new facets instead of all of them.
+  */
+private:
+	static int locate(PointSetView &points, vector<int> &ring, vector<double> &wedges, vector<bool> &after, int p, int eye)
+	{
+		double dx = points.x[p] - points.x[eye], dy = points.y[p] - points.y[eye], dz = points.z[p] - points.z[eye];
+		auto side = [&](int k) {				//positive if p comes before the half plane of ring[k]
+			return wedges[3 * k] * dx + wedges[3 * k + 1] * dy + wedges[3 * k + 2] * dz;
+		};
+		bool late = side(0) > 0;				//p is more than half a turn after ring[0]
+		int low = 0, high = ring.size();		//the half plane of ring[low] is not after p, the one of ring[high] is
+		while(high - low > 1)
+		{
+			int mid = (low + high) / 2;
+			if(after[mid] != late ? late : side(mid) <= 0)
+				low = mid;
+			else
+				high = mid;
+		}
+		return ring[low];
+	}
+
+/**
+  *\fn static bool tetrahedron(PointSetView &points, double tolerance, int corner[4])
+  *\param PointSetView &points
+  *\param double tolerance
+  *\param int corner[4] to store the corners
+  *\return false if all the points are on one plane
+  *
+  *\brief Find four points which span a large tetrahedron
+  *
+  *The first corner has the least x, the second is the farthest from it, the third is the farthest from the line through both
+  *and the fourth is the farthest from the plane through the three.
+  *The first three are ordered so that the fourth is below them, i.e. the facet faces out.
+  */
+private:
+	static bool tetrahedron(PointSetView &points, double tolerance, int corner[4])
+	{
+		int iter, n = points.size;
+		const double *x = points.x, *y = points.y, *z = points.z;
+
+		int a = 0;
+		for(iter = 1; iter < n; iter++)
+			if(x[iter] < x[a])
+				a = iter;
+
+		int b = a;
+		double best = 0;
+		for(iter = 0; iter < n; iter++)
+		{
+			double dx = x[iter] - x[a], dy = y[iter] - y[a], dz = z[iter] - z[a];
+			double length = dx * dx + dy * dy + dz * dz;
+			if(length > best)
+			{
+				best = length;
+				b = iter;
+			}
+		}
+		if(sqrt(best) <= tolerance)
+			return false;
+
+		int c = a;
+		double ux = x[b] - x[a], uy = y[b] - y[a], uz = z[b] - z[a];
+		double unit = sqrt(ux * ux + uy * uy + uz * uz);
+		best = 0;
+		for(iter = 0; iter < n; iter++)
+		{
+			double dx = x[iter] - x[a], dy = y[iter] - y[a], dz = z[iter] - z[a];
+			double cx = uy * dz - uz * dy, cy = uz * dx - ux * dz, cz = ux * dy - uy * dx;
+			double area = cx * cx + cy * cy + cz * cz;
+			if(area > best)
+			{
+				best = area;
+				c = iter;
+			}
+		}
+		if(sqrt(best) / unit <= tolerance)
+			return false;
+
+		Face plane = makeFace(points, a, b, c);
+		int d = a;
+		best = 0;
+		for(iter = 0; iter < n; iter++)
+		{
+			double height = fabs(distance(plane, x[iter], y[iter], z[iter]));
+			if(height > best)
+			{
+				best = height;
+				d = iter;
+			}
+		}
+		if(best <= tolerance)
+			return false;
+
+		if(distance(plane, x[d], y[d], z[d]) > 0)
+			swap(b, c);
+		corner[0] = a;
+		corner[1] = b;
+		corner[2] = c;
+		corner[3] = d;
+		return true;
+	}
+
+/**
+  *\fn static Face makeFace(PointSetView &points, int a, int b, int c)
+  *\param PointSetView &points
+  *\param int a, b, c the corners in anti-clockwise order as seen from outside
+  *\return the facet with its plane, not linked to any other facet yet
+  */
+private:
+	static Face makeFace(PointSetView &points, int a, int b, int c)
+	{
+		const double *x = points.x, *y = points.y, *z = points.z;
+		Face face;
+		face.vertex[0] = a;
+		face.vertex[1] = b;
+		face.vertex[2] = c;
+		face.neighbour[0] = face.neighbour[1] = face.neighbour[2] = -1;
+		double ux = x[b] - x[a], uy = y[b] - y[a], uz = z[b] - z[a];
+		double vx = x[c] - x[a], vy = y[c] - y[a], vz = z[c] - z[a];
+		face.nx = uy * vz - uz * vy;
+		face.ny = uz * vx - ux * vz;
+		face.nz = ux * vy - uy * vx;
+		double length = sqrt(face.nx * face.nx + face.ny * face.ny + face.nz * face.nz);
+		if(length > 0)
+		{
+			face.nx /= length;
+			face.ny /= length;
+			face.nz /= length;
+		}
+		face.offset = face.nx * x[a] + face.ny * y[a] + face.nz * z[a];
+		face.farthest = -1;
+		face.height = 0;
+		face.visited = 0;
+		face.alive = true;
+		return face;
+	}
+
+/**
+  *\fn static double distance(const Face &face, double px, double py, double pz)
+  *\return the signed distance of the point from the plane of the facet, positive above it
+  */
+private:
+	static double distance(const Face &face, double px, double py, double pz)
+	{
+		return face.nx * px + face.ny * py + face.nz * pz - face.offset;
+	}
+
+/**
+  *\fn static bool assign(PointSetView &points, Face &face, int p, double tolerance)
+  *\param PointSetView &points
+  *\param Face &face
+  *\param int p
+  *\param double tolerance
+  *\return true if the point is above the facet, it is then added to the outside set of the facet
+  */
+private:
+	static bool assign(PointSetView &points, Face &face, int p, double tolerance)
+	{
+		double height = distance(face, points.x[p], points.y[p], points.z[p]);
+		if(height <= tolerance)
+			return false;
+		face.outside.push_back(p);
+		if(height > face.height)
+		{
+			face.height = height;
+			face.farthest = p;
+		}
+		return true;
+	}
+
+/**
+  *\var static constexpr double TOLERANCE
+  *\brief The tolerance of the distance tests, relative to the largest co-ordinate.
+  *
+  *\var static const int MIN_RING
+  *\brief The least number of new facets for which the points of the removed facets are located with a binary search.
+  *With fewer new facets, testing them one by one is faster.
+  */
+private:
+	static constexpr double TOLERANCE = 1e-12;
+	static const int MIN_RING = 512;
+};
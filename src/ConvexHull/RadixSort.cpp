@@ -0,0 +1,297 @@
+/**\file: RadixSort.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Sort points by their co-ordinates with a radix sort instead of comparisons.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *Every double is mapped to a 64 bit integer key with the same order, so the keys can be sorted 11 bits at a time.
+  *The indices of the points are sorted by the keys of x with a least significant digit radix sort.
+  *Then every run of points with the same x is sorted by y, with another radix sort if it is large.
+  *A digit which is the same for all the keys is skipped, so co-ordinates in a small range need fewer passes.
+  *The time complexity is O(n) for every pass, at most 6 passes for the x co-ordinates.
+  *The parallel version splits every pass between the threads, each thread counting and moving its own part of the array.
+  *Any hull algorithm which sorts the points by x and then by y can use it, Andrew's Algorithm does with HullOptions::radixSort.
+  *sortBy sorts by a single number per point, Graham Scan uses it for the angles.
+  *Points on an integer grid are sorted by a single key made of both co-ordinates, in a single radix sort.
+  */
+class RadixSort
+{
+/**
+  *\fn static uint64_t key(double value)
+  *\param double value
+  *\return an integer key, the keys of two doubles compare like the doubles
+  *
+  *\brief The bits of a positive double are ordered like the double if the sign bit is set,
+  *the bits of a negative double are ordered the other way round and all of them are flipped.
+  *-0.0 gets the key of 0.0. NaN is not supported.
+  */
+public:
+	static uint64_t key(double value)
+	{
+		uint64_t bits;
+		value += 0.0;							//-0.0 becomes 0.0
+		memcpy(&bits, &value, sizeof(bits));
+		return (bits >> 63) ? ~bits : bits | ((uint64_t)1 << 63);
+	}
+
+/**
+  *\fn static void sortXY(PointSetView points, vector<int> &order, int threads)
+  *\param PointSetView points
+  *\param vector<int> &order the indices of the points to sort, sorted in place
+  *\param int threads zero or less means the number of hardware threads
+  *
+  *\brief Sort the indices by x and then by y of their points.
+  *
+  *The sort is stable, i.e. the indices of equal points keep their order.
+  *Small arrays are sorted with stable_sort, which is faster for them.
+  */
+public:
+	static void sortXY(PointSetView points, vector<int> &order, int threads = 1)
+	{
+		const double *x = points.x, *y = points.y;
+		int n = order.size();
+		if(n < MIN_RADIX)
+		{
+			stable_sort(order.begin(), order.end(), [x, y](int A, int B) {
+				return x[A] < x[B] || (x[A] == x[B] && y[A] < y[B]);
+			});
+			return;
+		}
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		threads = max(1, min(threads, n / MIN_RADIX));
+
+		vector<Item> items(n), buffer(n);
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				items[iter].key = key(x[order[iter]]);
+				items[iter].index = order[iter];
+			}
+		});
+		sortItems(items, buffer, threads);
+
+		for(int begin = 0, end; begin < n; begin = end)	//sort the runs with the same x by y
+		{
+			for(end = begin + 1; end < n && items[end].key == items[begin].key; end++);
+			if(end - begin < 2)
+				continue;
+			vector<Item> run(items.begin() + begin, items.begin() + end), spare(end - begin);
+			for(Item &item : run)
+				item.key = key(y[item.index]);
+			if(end - begin < MIN_RADIX)
+				stable_sort(run.begin(), run.end(), [](const Item &A, const Item &B) { return A.key < B.key; });
+			else
+				sortItems(run, spare, max(1, min(threads, (end - begin) / MIN_RADIX)));
+			copy(run.begin(), run.end(), items.begin() + begin);
+		}
+
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+				order[iter] = items[iter].index;
+		});
+	}
+
+/**
+  *\fn static uint64_t key(int x, int y)
+  *\param int x
+  *\param int y
+  *\return an integer key, the keys of two points on an integer grid compare like the points by x and then by y
+  *
+  *\brief The sign bit of each co-ordinate is flipped, so it is ordered like an unsigned number, and x takes the upper 32 bits.
+  */
+public:
+	static uint64_t key(int x, int y)
+	{
+		return ((uint64_t)((uint32_t)x ^ 0x80000000u) << 32) | ((uint32_t)y ^ 0x80000000u);
+	}
+
+/**
+  *\fn static void sortXY(BasicPointSetView<int> points, vector<int> &order, int threads)
+  *\param BasicPointSetView<int> points
+  *\param vector<int> &order the indices of the points to sort, sorted in place
+  *\param int threads zero or less means the number of hardware threads
+  *
+  *\brief Sort the indices of points on an integer grid by x and then by y of their points.
+  *
+  *Both co-ordinates fit in a single key, so there is no second sort of the runs with the same x.
+  *As for doubles, the passes of the digits which are the same for all the keys are skipped.
+  */
+public:
+	static void sortXY(BasicPointSetView<int> points, vector<int> &order, int threads = 1)
+	{
+		const int *x = points.x, *y = points.y;
+		int n = order.size();
+		if(n < MIN_RADIX)
+		{
+			stable_sort(order.begin(), order.end(), [x, y](int A, int B) {
+				return x[A] < x[B] || (x[A] == x[B] && y[A] < y[B]);
+			});
+			return;
+		}
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		threads = max(1, min(threads, n / MIN_RADIX));
+
+		vector<Item> items(n), buffer(n);
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				items[iter].key = key(x[order[iter]], y[order[iter]]);
+				items[iter].index = order[iter];
+			}
+		});
+		sortItems(items, buffer, threads);
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+				order[iter] = items[iter].index;
+		});
+	}
+
+/**
+  *\fn static void sortBy(const double *values, vector<int> &order, int threads)
+  *\param const double *values one number for every index
+  *\param vector<int> &order the indices to sort, sorted in place
+  *\param int threads zero or less means the number of hardware threads
+  *
+  *\brief Stable sort of the indices by values, e.g. by the angle of their points as in Graham Scan.
+  */
+public:
+	static void sortBy(const double *values, vector<int> &order, int threads = 1)
+	{
+		int n = order.size();
+		if(n < MIN_RADIX)
+		{
+			stable_sort(order.begin(), order.end(), [values](int A, int B) {
+				return values[A] < values[B];
+			});
+			return;
+		}
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		threads = max(1, min(threads, n / MIN_RADIX));
+
+		vector<Item> items(n), buffer(n);
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				items[iter].key = key(values[order[iter]]);
+				items[iter].index = order[iter];
+			}
+		});
+		sortItems(items, buffer, threads);
+		forEachPart(n, threads, [&](int, int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+				order[iter] = items[iter].index;
+		});
+	}
+
+/**
+  *\var struct Item
+  *\brief A key with the index of its point, moved together by the passes.
+  */
+private:
+	struct Item
+	{
+		uint64_t key;
+		int index;
+	};
+
+/**
+  *\fn static void sortItems(vector<Item> &items, vector<Item> &buffer, int threads)
+  *
+  *\brief Stable sort of the items by their keys, one digit of 11 bits per pass from the least significant one.
+  *
+  *The digits of all the passes are counted at once, and a pass is skipped if all the keys have the same digit.
+  *Otherwise every thread moves its part of the items to the buffer, starting every digit after the same digit of the threads before it,
+  *which keeps the sort stable. Then the buffer and the items are swapped.
+  *As a pass moves the items between the parts, the threads count the digit of their own part again before every pass.
+  */
+private:
+	static void sortItems(vector<Item> &items, vector<Item> &buffer, int threads)
+	{
+		const int BITS = 11, DIGITS = 1 << BITS, PASSES = (64 + BITS - 1) / BITS;
+		int n = items.size();
+		vector<int> counts(threads * PASSES * DIGITS, 0);	//counts[(thread * PASSES + pass) * DIGITS + digit]
+		forEachPart(n, threads, [&](int part, int begin, int end) {
+			int *count = counts.data() + part * PASSES * DIGITS;
+			for(int iter = begin; iter < end; iter++)
+			{
+				uint64_t k = items[iter].key;
+				for(int pass = 0; pass < PASSES; pass++)
+					count[pass * DIGITS + ((k >> (BITS * pass)) & (DIGITS - 1))]++;
+			}
+		});
+		vector<bool> trivial(PASSES, false);
+		for(int pass = 0; pass < PASSES; pass++)
+			for(int digit = 0; digit < DIGITS; digit++)
+			{
+				int total = 0;
+				for(int part = 0; part < threads; part++)
+					total += counts[(part * PASSES + pass) * DIGITS + digit];
+				if(total == n)
+					trivial[pass] = true;
+			}
+
+		bool moved = false;
+		vector<int> starts(threads * DIGITS);
+		for(int pass = 0; pass < PASSES; pass++)
+		{
+			if(trivial[pass])
+				continue;
+			int shift = BITS * pass;
+			if(moved && threads > 1)			//count this digit of the parts again
+				forEachPart(n, threads, [&](int part, int begin, int end) {
+					int *count = counts.data() + (part * PASSES + pass) * DIGITS;
+					fill(count, count + DIGITS, 0);
+					for(int iter = begin; iter < end; iter++)
+						count[(items[iter].key >> shift) & (DIGITS - 1)]++;
+				});
+			int sum = 0;
+			for(int digit = 0; digit < DIGITS; digit++)
+				for(int part = 0; part < threads; part++)
+				{
+					starts[part * DIGITS + digit] = sum;
+					sum += counts[(part * PASSES + pass) * DIGITS + digit];
+				}
+			forEachPart(n, threads, [&](int part, int begin, int end) {
+				int *start = starts.data() + part * DIGITS;
+				for(int iter = begin; iter < end; iter++)
+					buffer[start[(items[iter].key >> shift) & (DIGITS - 1)]++] = items[iter];
+			});
+			items.swap(buffer);
+			moved = true;
+		}
+	}
+
+/**
+  *\fn template<class Call> static void forEachPart(int n, int parts, Call call)
+  *
+  *\brief Split 0 to n into parts of about the same size and call call(part, begin, end) for each of them, every part on its own thread.
+  *
+  *The same split is used every time, so a thread counts and moves the same items.
+  */
+private:
+	template<class Call>
+	static void forEachPart(int n, int parts, Call call)
+	{
+		vector<thread> workers;
+		for(int part = 1; part < parts; part++)
+			workers.push_back(thread([&call, part, parts, n]() {
+				call(part, (long long)n * part / parts, (long long)n * (part + 1) / parts);
+			}));
+		call(0, 0, (long long)n / parts);
+		for(thread &t : workers)
+			t.join();
+	}
+
+/**
+  *\var static const int MIN_RADIX
+  *\brief Arrays smaller than this are sorted with stable_sort, and every thread gets at least this many items.
+  */
+private:
+	static const int MIN_RADIX = 1 << 10;
+};
@@ -0,0 +1,141 @@
+/**\file: StreamingHull.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Get convex hull of points read from standard input or a file, without keeping all of them in memory.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The points are read in chunks of a fixed size with GetPoints::getChunk.
+  *The hull of every chunk is found with QuickHull and merged into the hull of the chunks before it with MergeHull.
+  *Only the current chunk and the corners of the hull are in memory, so the memory is O(chunk + h) for any size of the input.
+  *The time complexity is O(nlogh) on average, like QuickHull.
+  *As only the hull is kept, the .ch file has the corners of the hull as its points.
+  */
+class StreamingHull
+{
+/**
+  *\fn static Polygon convexHullStream(FILE *source, int chunkSize, int threads)
+  *\param FILE *source stdin or a file opened for reading
+  *\param int chunkSize the number of points read at once
+  *\param int threads
+  *\return Polygon which is the convex hull of all the points of source
+  *
+  *\brief A function to get convex hull of a stream of points.
+  *
+  *The points are x, y and z co-ordinates separated by white space, see GetPoints::getChunk.
+  *The hull starts at the point with least x (and least y among them) and runs clockwise, like the one of Andrew's Algorithm.
+  *Only the corners of the hull are returned.
+  *threads is used for the hull of every chunk, zero or less means the number of hardware threads and one means no pool.
+  *
+  */
+public:
+	static Polygon convexHullStream(FILE *source, int chunkSize = 1 << 20, int threads = 0)
+	{
+		PointSet hull = StreamAlgo(source, chunkSize, threads);
+		Polygon result;									//create a polygon
+		for(int iter = 0; iter < hull.getSize(); iter++)
+			result.insertAtLast(hull.getPoint(iter));	//pass the points on convex hull to the polygon
+		return result;
+	}
+
+/**
+  *\fn static Polygon convexHullStream(string filepath, int chunkSize, int threads)
+  *\param string filepath
+  *\param int chunkSize
+  *\param int threads
+  *\return Polygon which is the convex hull of the points in the file
+  *
+  *\brief A function to get convex hull of the points in a file, read in chunks.
+  *
+  *An empty Polygon is returned if the file can not be opened.
+  *
+  */
+public:
+	static Polygon convexHullStream(string filepath, int chunkSize = 1 << 20, int threads = 0)
+	{
+		FILE *source = fopen(filepath.c_str(), "r");
+		if(source == NULL)
+			return Polygon();
+		Polygon result = convexHullStream(source, chunkSize, threads);
+		fclose(source);
+		return result;
+	}
+
+/**
+  *\fn static void convexHullStreamToCH(FILE *source, string filepath, int chunkSize, int threads)
+  *\param FILE *source
+  *\param string filepath
+  *\param int chunkSize
+  *\param int threads
+  *\return void
+  *
+  *\brief A function to get .ch file of the convex hull of a stream of points.
+  *
+  *The points of the file are the corners of the hull in clockwise order, so the indices are 0 to h - 1.
+  *For details on .ch file, contact Dr. T Ray from BITS Pilani University.
+  *
+  */
+public:
+	static void convexHullStreamToCH(FILE *source, string filepath, int chunkSize = 1 << 20, int threads = 0)
+	{
+		PointSet hull = StreamAlgo(source, chunkSize, threads);
+		vector<int> ch(hull.getSize());
+		for(int iter = 0; iter < hull.getSize(); iter++)
+			ch[iter] = iter;
+		ExportToCH::write(hull.getView(), ch, filepath);
+	}
+
+/**
+  *\fn static PointSet StreamAlgo(FILE *source, int chunkSize, int threads)
+  *\param FILE *source
+  *\param int chunkSize
+  *\param int threads
+  *\return the corners of the hull in clockwise order
+  *
+  *\brief Read the chunks and merge their hulls into one.
+  *
+  *The memory of the chunk is reused for every chunk and one pool of threads is used for all of them.
+  */
+private:
+	static PointSet StreamAlgo(FILE *source, int chunkSize, int threads)
+	{
+		PointSet chunk(true), hull(true);
+		chunk.reserve(chunkSize);
+		unique_ptr<WorkStealingPool> pool;
+		if(threads != 1)
+			pool.reset(new WorkStealingPool(threads));
+		while(GetPoints::getChunk(source, chunk, chunkSize) > 0)
+		{
+			vector<int> ch = pool ? QuickHull::convexHullQuickIndices(chunk.getView(), *pool) : QuickHull::convexHullQuickIndices(chunk.getView(), 1);
+			merge(hull, chunk, ch);
+		}
+		return hull;
+	}
+
+/**
+  *\fn static void merge(PointSet &hull, const PointSet &chunk, const vector<int> &ch)
+  *\param PointSet &hull the corners of the hull so far, replaced by the merged hull
+  *\param const PointSet &chunk
+  *\param const vector<int> &ch the indices of the corners of the hull of chunk
+  *
+  *\brief Merge the hull of a chunk into the hull so far.
+  *
+  *The hull of the corners of both hulls is the hull of all the points read so far. It takes O(h) time.
+  */
+private:
+	static void merge(PointSet &hull, const PointSet &chunk, const vector<int> &ch)
+	{
+		PointSet both(true);
+		both.reserve(hull.getSize() + ch.size());
+		for(int iter = 0; iter < hull.getSize(); iter++)
+			both.insertAtLast(hull.getPoint(iter));
+		for(int i : ch)
+			both.insertAtLast(chunk.getPoint(i));
+		vector<int> corners = MergeHull::mergeHullsIndices(both.getView(), hull.getSize());
+		hull.clear();
+		for(int i : corners)
+			hull.insertAtLast(both.getPoint(i));
+	}
+};
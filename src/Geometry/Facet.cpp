@@ -0,0 +1,53 @@
+/**\file: Facet.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A class to represent a triangular facet of a surface in 3D.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *A facet does not store the points, only their indices in the set of points it was made from.
+  *The three variables a, b and c are the indices of its corners.
+  *For the facets of a convex hull the corners are in anti-clockwise order as seen from outside,
+  *so the normal from the right hand rule points out of the hull.
+  */
+class Facet
+{
+public:
+/**
+  *\var int a
+  *\brief the index of the first corner.
+  *
+  *\var int b
+  *\brief the index of the second corner.
+  *
+  *\var int c
+  *\brief the index of the third corner.
+  */
+	int a, b, c;
+
+public:
+/**
+  *\param int a
+  *\param int b
+  *\param int c
+  *
+  *\brief A constructor to initialize the facet with the given corners.
+  */
+	Facet(int a, int b, int c)
+	{
+		this->a = a;
+		this->b = b;
+		this->c = c;
+	}
+
+public:
+/**
+  *\brief A constructor to initialize the facet with all the corners at the first point.
+  */
+	Facet()
+	{
+		a = b = c = 0;
+	}
+};
@@ -0,0 +1,840 @@
+/**\file: Orientation.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A class with the orientation test used by all the hull algorithms.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The orientation of three points a, b and c is the sign of twice the signed area of the triangle abc.
+  *A positive area means that c is on the left of the line from a to b.
+  *Apart from the test for a single triple, the class has batch functions which test one edge ab against a block of points.
+  *The batch functions have a scalar, an SSE2 and an AVX2 version.
+  *The fastest version supported by the processor is picked when the program starts.
+  *All versions evaluate the area with the same expression, in the same order, so they give exactly the same results.
+  *
+  *The tests of the side of a point, i.e. checkDirection, turn, firstLeft and selectLeft, are exact.
+  *The area is first computed in plain floating point with a bound on its rounding error, which decides the sign almost always.
+  *Only the few triples which are too close to a line to decide are computed again with the adaptive expansion arithmetic of Shewchuk's orient2d.
+  *So the hull algorithms never see a point on both sides of a line, even on degenerate inputs, at nearly the cost of the plain test.
+  *For points on an integer grid, turn and checkDirection have overloads which compute the area exactly with integers.
+  */
+class Orientation
+{
+public:
+/**
+  *\var enum Kernel
+  *\brief The versions of the batch functions.
+  *
+  *SCALAR is always available.
+  *SSE2 and AVX2 are available only on x86 processors supporting them, with gcc or clang.
+  */
+	enum Kernel { SCALAR, SSE2, AVX2 };
+
+public:
+/**
+  *\fn static double area(double ax, double ay, double bx, double by, double cx, double cy)
+  *\return twice the signed area of the triangle abc
+  *
+  *\brief Get twice the signed area of the triangle with vertices (ax, ay), (bx, by) and (cx, cy).
+  *
+  *It is positive if c is on the left of the line from a to b.
+  */
+	static double area(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return ax * by - bx * ay + bx * cy - cx * by + cx * ay - ax * cy;
+	}
+
+public:
+/**
+  *\fn static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b, with the exact sign
+  *
+  *\brief The robust orientation test, computed with the differences to a.
+  *
+  *If the rounding error can not change the sign, the plain value (bx - ax) * (cy - ay) - (by - ay) * (cx - ax) is returned.
+  *Otherwise it is refined with turnExact, so the result is zero if and only if the three points are exactly on a line.
+  *The co-ordinates must be small enough for the products not to overflow and large enough for them not to underflow.
+  */
+	static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		double left = (bx - ax) * (cy - ay), right = (by - ay) * (cx - ax);
+		double det = left - right, sum = fabs(left) + fabs(right);
+		if(fabs(det) >= ERROR_A * sum)
+			return det;
+		return turnExact(ax, ay, bx, by, cx, cy, sum);
+	}
+
+public:
+/**
+  *\fn static int turn(int ax, int ay, int bx, int by, int cx, int cy)
+  *\return 1 if c is on the left of a to b, -1 if it is on the right and 0 if the three points are on a line
+  *
+  *\brief The orientation test for points on an integer grid, exact for any int co-ordinates without any floating point filter.
+  *
+  *The differences to a are computed with 64 bit integers and their products with 128 bit integers, which can not overflow.
+  *Without a 128 bit integer type the double version is used, which is exact as well since every int is a double.
+  */
+	static int turn(int ax, int ay, int bx, int by, int cx, int cy)
+	{
+#ifdef CGEO_INT128
+		__int128 left = (__int128)((int64_t)bx - ax) * ((int64_t)cy - ay);
+		__int128 right = (__int128)((int64_t)by - ay) * ((int64_t)cx - ax);
+		return (left > right) - (left < right);
+#else
+		double det = turn((double)ax, (double)ay, (double)bx, (double)by, (double)cx, (double)cy);
+		return (det > 0) - (det < 0);
+#endif
+	}
+
+public:
+/**
+  *\fn static bool checkDirection(const Point &a, const Point &b, const Point &c)
+  *\param const Point &a
+  *\param const Point &b
+  *\param const Point &c
+  *\return a boolean indicating the sign of area
+  *
+  *\brief Returns true if the signed area of the triangle abc is positive else returns false.
+  *
+  *The sign is exact, see turn.
+  */
+	static bool checkDirection(const Point &a, const Point &b, const Point &c)
+	{
+		return turn(a.x, a.y, b.x, b.y, c.x, c.y) > 0;
+	}
+
+public:
+/**
+  *\fn static bool checkDirection(const PointSetView &points, int a, int b, int c)
+  *\param const PointSetView &points
+  *\param int a
+  *\param int b
+  *\param int c
+  *\return a boolean indicating the sign of area
+  *
+  *\brief The same check for the points at indices a, b and c of the view.
+  */
+	static bool checkDirection(const PointSetView &points, int a, int b, int c)
+	{
+		const double *x = points.x, *y = points.y;
+		return turn(x[a], y[a], x[b], y[b], x[c], y[c]) > 0;
+	}
+
+public:
+/**
+  *\fn static bool checkDirection(const BasicPointSetView<int> &points, int a, int b, int c)
+  *\param const BasicPointSetView<int> &points
+  *\param int a
+  *\param int b
+  *\param int c
+  *\return a boolean indicating the sign of area
+  *
+  *\brief The same check for points on an integer grid, with the exact integer turn.
+  */
+	static bool checkDirection(const BasicPointSetView<int> &points, int a, int b, int c)
+	{
+		const int *x = points.x, *y = points.y;
+		return turn(x[a], y[a], x[b], y[b], x[c], y[c]) > 0;
+	}
+
+public:
+/**
+  *\fn static void areas(double ax, double ay, double bx, double by, const double *x, const double *y, int n, double *out)
+  *\param double ax, ay, bx, by the edge
+  *\param const double *x
+  *\param const double *y
+  *\param int n
+  *\param double *out
+  *
+  *\brief Get the area of the edge ab with each of the n points.
+  *
+  *out[i] is set to area(ax, ay, bx, by, x[i], y[i]).
+  */
+	static void areas(double ax, double ay, double bx, double by, const double *x, const double *y, int n, double *out)
+	{
+		kernels().areas(ax, ay, bx, by, x, y, n, out);
+	}
+
+public:
+/**
+  *\fn static int firstLeft(double ax, double ay, double bx, double by, const double *x, const double *y, int begin, int end)
+  *\return the first index on the left of ab, or -1
+  *
+  *\brief Find the first point from begin to end - 1 which is on the left of the edge ab.
+  *
+  *A point is on the left if its turn with ab is positive, the test is exact.
+  *Returns -1 if there is no such point.
+  *The scan of Jarvis' March is built on this function.
+  */
+	static int firstLeft(double ax, double ay, double bx, double by, const double *x, const double *y, int begin, int end)
+	{
+		return kernels().firstLeft(ax, ay, bx, by, x, y, begin, end);
+	}
+
+public:
+/**
+  *\fn static int selectLeft(double ax, double ay, double bx, double by, const double *x, const double *y, const int *index, int n, int *out)
+  *\param const int *index the indices of the points to test, NULL for 0 to n - 1
+  *\param int *out the array to store the indices of the points on the left
+  *\return the number of indices stored in out
+  *
+  *\brief Keep only the points which are on the left of the edge ab.
+  *
+  *A point is on the left if its turn with ab is positive, the test is exact.
+  *The order of the indices is maintained.
+  *out may be the same array as index, the points are filtered in place then.
+  *The filtering passes of the hull algorithms are built on this function.
+  */
+	static int selectLeft(double ax, double ay, double bx, double by, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		return kernels().selectLeft(ax, ay, bx, by, x, y, index, n, out);
+	}
+
+public:
+/**
+  *\fn static int selectOutside(const double *px, const double *py, int m, const double *x, const double *y, const int *index, int n, int *out)
+  *\param const double *px, *py the vertices of a convex polygon in anti-clockwise order
+  *\param int m the number of vertices
+  *\param const int *index the indices of the points to test, NULL for 0 to n - 1
+  *\param int *out the array to store the indices of the points which are kept
+  *\return the number of indices stored in out
+  *
+  *\brief Drop the points which are strictly inside a convex polygon.
+  *
+  *A point is strictly inside if it is on the left of every edge of the polygon.
+  *The test is done with the differences to the edge start and a bound on the rounding error,
+  *so a point on an edge or too close to it to decide, e.g. a vertex of the polygon, is always kept.
+  *All the other points are kept, in the same order.
+  *out may be the same array as index.
+  */
+	static int selectOutside(const double *px, const double *py, int m, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		return kernels().selectOutside(px, py, m, x, y, index, n, out);
+	}
+
+public:
+/**
+  *\fn static Kernel getKernel(void)
+  *\return the kernel used by the batch functions
+  *
+  *\brief Get the version of the batch functions which is currently used.
+  */
+	static Kernel getKernel(void)
+	{
+		return kernels().kernel;
+	}
+
+public:
+/**
+  *\fn static bool setKernel(Kernel kernel)
+  *\param Kernel kernel
+  *\return false if the kernel is not supported on this machine
+  *
+  *\brief Force a version of the batch functions, mostly for testing and benchmarking.
+  *
+  *It is not safe to call it while other threads use the batch functions.
+  */
+	static bool setKernel(Kernel kernel)
+	{
+		if(!isSupported(kernel))
+			return false;
+		kernels() = makeTable(kernel);
+		return true;
+	}
+
+public:
+/**
+  *\fn static bool isSupported(Kernel kernel)
+  *\param Kernel kernel
+  *\return true if the kernel can be used on this machine
+  *
+  *\brief Check if the processor and the compiler support a version of the batch functions.
+  */
+	static bool isSupported(Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		__builtin_cpu_init();
+		if(kernel == AVX2)
+			return __builtin_cpu_supports("avx2");
+		if(kernel == SSE2)
+			return __builtin_cpu_supports("sse2");
+#endif
+		return kernel == SCALAR;
+	}
+
+/**
+  *\var struct Table
+  *\brief The batch functions currently used, picked once at the first call.
+  */
+private:
+	struct Table
+	{
+		Kernel kernel;
+		void (*areas)(double, double, double, double, const double *, const double *, int, double *);
+		int (*firstLeft)(double, double, double, double, const double *, const double *, int, int);
+		int (*selectLeft)(double, double, double, double, const double *, const double *, const int *, int, int *);
+		int (*selectOutside)(const double *, const double *, int, const double *, const double *, const int *, int, int *);
+	};
+
+/**
+  *\fn static Table &kernels(void)
+  *\return the table of batch functions
+  *
+  *\brief Returns the table, filling it with the fastest supported version at the first call.
+  */
+private:
+	static Table &kernels(void)
+	{
+		static Table table = detect();
+		return table;
+	}
+
+/**
+  *\fn static Table detect(void)
+  *\return the table of the fastest supported version
+  */
+private:
+	static Table detect(void)
+	{
+		if(isSupported(AVX2))
+			return makeTable(AVX2);
+		if(isSupported(SSE2))
+			return makeTable(SSE2);
+		return makeTable(SCALAR);
+	}
+
+/**
+  *\fn static Table makeTable(Kernel kernel)
+  *\return the table of the given version
+  */
+private:
+	static Table makeTable(Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		if(kernel == AVX2)
+			return {AVX2, areasAVX2, firstLeftAVX2, selectLeftAVX2, selectOutsideAVX2};
+		if(kernel == SSE2)
+			return {SSE2, areasSSE2, firstLeftSSE2, selectLeftSSE2, selectOutsideSSE2};
+#endif
+		return {SCALAR, areasScalar, firstLeftScalar, selectLeftScalar, selectOutsideScalar};
+	}
+
+/**
+  *Scalar versions of the batch functions.
+  */
+private:
+	static void areasScalar(double ax, double ay, double bx, double by, const double *x, const double *y, int n, double *out)
+	{
+		for(int i = 0; i < n; i++)
+			out[i] = area(ax, ay, bx, by, x[i], y[i]);
+	}
+
+private:
+	static int firstLeftScalar(double ax, double ay, double bx, double by, const double *x, const double *y, int begin, int end)
+	{
+		for(int i = begin; i < end; i++)
+			if(turn(ax, ay, bx, by, x[i], y[i]) > 0)
+				return i;
+		return -1;
+	}
+
+private:
+	static int selectLeftScalar(double ax, double ay, double bx, double by, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		int count = 0;
+		for(int i = 0; i < n; i++)
+		{
+			int j = index ? index[i] : i;
+			out[count] = j;						//branchless, out may alias index
+			count += turn(ax, ay, bx, by, x[j], y[j]) > 0;
+		}
+		return count;
+	}
+
+private:
+	static int selectOutsideScalar(const double *px, const double *py, int m, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		int count = 0;
+		for(int i = 0; i < n; i++)
+		{
+			int j = index ? index[i] : i;
+			out[count] = j;
+			count += !strictlyInside(px, py, m, x[j], y[j]);
+		}
+		return count;
+	}
+
+private:
+	static bool strictlyInside(const double *px, const double *py, int m, double cx, double cy)
+	{
+		bool inside = true;
+		for(int k = 0; k < m; k++)
+		{
+			int l = (k + 1) % m;
+			double left = (px[l] - px[k]) * (cy - py[k]), right = (py[l] - py[k]) * (cx - px[k]);
+			inside &= left - right > INSIDE_BOUND * (fabs(left) + fabs(right));
+		}
+		return inside;
+	}
+
+/**
+  *\var static const double INSIDE_BOUND
+  *\brief The relative error bound of the translated area, a little larger than the one of Shewchuk's orient2d.
+  */
+private:
+	static constexpr double INSIDE_BOUND = 1e-15;
+
+/**
+  *\var static constexpr double EPSILON, SPLITTER
+  *\brief Half the distance from 1 to the next double, and the constant which splits a double into two halves of 26 bits.
+  *
+  *\var static constexpr double ERROR_A, ERROR_B, ERROR_C, RESULT_ERROR
+  *\brief The relative error bounds of the stages of turnExact, from Shewchuk's orient2d.
+  */
+private:
+	static constexpr double EPSILON = 1.1102230246251565e-16;
+	static constexpr double SPLITTER = 134217729.0;
+	static constexpr double ERROR_A = (3.0 + 16.0 * EPSILON) * EPSILON;
+	static constexpr double ERROR_B = (2.0 + 12.0 * EPSILON) * EPSILON;
+	static constexpr double ERROR_C = (9.0 + 64.0 * EPSILON) * EPSILON * EPSILON;
+	static constexpr double RESULT_ERROR = (3.0 + 8.0 * EPSILON) * EPSILON;
+
+/**
+  *\fn static double turnExact(double ax, double ay, double bx, double by, double cx, double cy, double sum)
+  *\param double sum |(bx - ax) * (cy - ay)| + |(by - ay) * (cx - ax)| as computed by turn
+  *\return the turn of abc with the exact sign
+  *
+  *\brief The adaptive stages of Shewchuk's orient2d, with a as the point the differences are taken to.
+  *
+  *The products of the rounded differences are first computed exactly, which is enough if the differences were exact.
+  *Then the rounding errors of the differences are added, first approximately and at last exactly.
+  *Every stage stops as soon as its error bound shows that the sign is right, so a triple costs only as much as it needs.
+  *An expansion is a sum of doubles which do not overlap, from the smallest to the largest, and its sign is the one of its largest part.
+  */
+private:
+	static double turnExact(double ax, double ay, double bx, double by, double cx, double cy, double sum)
+	{
+		double abx = bx - ax, acx = cx - ax, aby = by - ay, acy = cy - ay;
+		double B[4], C1[8], C2[12], D[16], u[4];
+		productDiff(abx, acy, aby, acx, B);
+		double det = B[0] + B[1] + B[2] + B[3];
+		if(fabs(det) >= ERROR_B * sum)
+			return det;
+
+		double abxTail = diffTail(bx, ax, abx), acxTail = diffTail(cx, ax, acx);
+		double abyTail = diffTail(by, ay, aby), acyTail = diffTail(cy, ay, acy);
+		if(abxTail == 0 && acxTail == 0 && abyTail == 0 && acyTail == 0)
+			return det;
+		double bound = ERROR_C * sum + RESULT_ERROR * fabs(det);
+		det += (abx * acyTail + acy * abxTail) - (aby * acxTail + acx * abyTail);
+		if(fabs(det) >= bound)
+			return det;
+
+		productDiff(abxTail, acy, abyTail, acx, u);
+		int c1 = expansionSum(B, 4, u, 4, C1);
+		productDiff(abx, acyTail, aby, acxTail, u);
+		int c2 = expansionSum(C1, c1, u, 4, C2);
+		productDiff(abxTail, acyTail, abyTail, acxTail, u);
+		int d = expansionSum(C2, c2, u, 4, D);
+		return D[d - 1];
+	}
+
+/**
+  *\fn static double diffTail(double a, double b, double x)
+  *\return the rounding error of x = a - b, so that a - b = x + tail exactly
+  */
+private:
+	static double diffTail(double a, double b, double x)
+	{
+		double bVirtual = a - x, aVirtual = x + bVirtual;
+		return (a - aVirtual) + (bVirtual - b);
+	}
+
+/**
+  *\fn static void twoSum(double a, double b, double &x, double &y)
+  *\brief x = a + b rounded and y its rounding error, so that a + b = x + y exactly.
+  */
+private:
+	static void twoSum(double a, double b, double &x, double &y)
+	{
+		x = a + b;
+		double bVirtual = x - a, aVirtual = x - bVirtual;
+		y = (a - aVirtual) + (b - bVirtual);
+	}
+
+/**
+  *\fn static void twoProduct(double a, double b, double &x, double &y)
+  *\brief x = a * b rounded and y its rounding error, so that a * b = x + y exactly.
+  *
+  *With a fast fused multiply add, the error is a single fma, otherwise both numbers are split in halves whose products are exact.
+  */
+private:
+	static void twoProduct(double a, double b, double &x, double &y)
+	{
+		x = a * b;
+#ifdef FP_FAST_FMA
+		y = fma(a, b, -x);
+#else
+		double c = SPLITTER * a, aHigh = c - (c - a), aLow = a - aHigh;
+		double d = SPLITTER * b, bHigh = d - (d - b), bLow = b - bHigh;
+		y = aLow * bLow - (((x - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow);
+#endif
+	}
+
+/**
+  *\fn static void productDiff(double a, double b, double c, double d, double *out)
+  *\brief The expansion of 4 parts of a * b - c * d, exactly.
+  */
+private:
+	static void productDiff(double a, double b, double c, double d, double *out)
+	{
+		double s1, s0, t1, t0, i, j, k;
+		twoProduct(a, b, s1, s0);
+		twoProduct(c, d, t1, t0);
+		twoSum(s0, -t0, i, out[0]);
+		twoSum(s1, i, j, k);
+		twoSum(k, -t1, i, out[1]);
+		twoSum(j, i, out[3], out[2]);
+	}
+
+/**
+  *\fn static int expansionSum(const double *e, int m, const double *f, int n, double *out)
+  *\return the number of parts of out, the expansion of the sum of the expansions e and f
+  *
+  *\brief The parts of both are added from the smallest one, like a merge, and the zero parts are dropped.
+  */
+private:
+	static int expansionSum(const double *e, int m, const double *f, int n, double *out)
+	{
+		int i = 0, j = 0, count = 0;
+		double q, sum, error;
+		if(fabs(f[0]) > fabs(e[0]))
+			q = e[i++];
+		else
+			q = f[j++];
+		while(i < m || j < n)
+		{
+			double next = j == n || (i < m && fabs(f[j]) > fabs(e[i])) ? e[i++] : f[j++];
+			twoSum(q, next, sum, error);
+			q = sum;
+			if(error != 0)
+				out[count++] = error;
+		}
+		if(q != 0 || count == 0)
+			out[count++] = q;
+		return count;
+	}
+
+#ifdef CGEO_X86_SIMD
+/**
+  *SSE2 versions of the batch functions, two points at a time.
+  *The area is evaluated as ((((ab + bx*cy) - cx*by) + cx*ay) - ax*cy) with ab = ax*by - bx*ay, like area().
+  */
+private:
+	__attribute__((target("sse2")))
+	static __m128d areaSSE2(__m128d ab, __m128d ax, __m128d ay, __m128d bx, __m128d by, __m128d cx, __m128d cy)
+	{
+		__m128d t = _mm_add_pd(ab, _mm_mul_pd(bx, cy));
+		t = _mm_sub_pd(t, _mm_mul_pd(cx, by));
+		t = _mm_add_pd(t, _mm_mul_pd(cx, ay));
+		return _mm_sub_pd(t, _mm_mul_pd(ax, cy));
+	}
+
+/**
+  *\fn static int leftSSE2(double ax, double ay, double bx, double by, __m128d cx, __m128d cy)
+  *\return the mask of the two points which are on the left of ab
+  *
+  *\brief The filter of turn on two points, the points it can not decide are tested with turn one by one.
+  */
+private:
+	__attribute__((target("sse2")))
+	static int leftSSE2(double ax, double ay, double bx, double by, __m128d cx, __m128d cy)
+	{
+		__m128d sign = _mm_set1_pd(-0.0);
+		__m128d left = _mm_mul_pd(_mm_set1_pd(bx - ax), _mm_sub_pd(cy, _mm_set1_pd(ay)));
+		__m128d right = _mm_mul_pd(_mm_set1_pd(by - ay), _mm_sub_pd(cx, _mm_set1_pd(ax)));
+		__m128d det = _mm_sub_pd(left, right);
+		__m128d bound = _mm_mul_pd(_mm_set1_pd(ERROR_A), _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+		int mask = _mm_movemask_pd(_mm_cmpgt_pd(det, _mm_setzero_pd()));
+		int unsure = ~_mm_movemask_pd(_mm_cmpge_pd(_mm_andnot_pd(sign, det), bound)) & 3;
+		if(unsure)
+		{
+			double px[2], py[2];
+			_mm_storeu_pd(px, cx);
+			_mm_storeu_pd(py, cy);
+			for(int lane = 0; lane < 2; lane++)
+				if(unsure >> lane & 1)
+					mask = (mask & ~(1 << lane)) | (turn(ax, ay, bx, by, px[lane], py[lane]) > 0) << lane;
+		}
+		return mask;
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static void areasSSE2(double ax, double ay, double bx, double by, const double *x, const double *y, int n, double *out)
+	{
+		__m128d vab = _mm_set1_pd(ax * by - bx * ay);
+		__m128d vax = _mm_set1_pd(ax), vay = _mm_set1_pd(ay), vbx = _mm_set1_pd(bx), vby = _mm_set1_pd(by);
+		int i = 0;
+		for(; i + 2 <= n; i += 2)
+			_mm_storeu_pd(out + i, areaSSE2(vab, vax, vay, vbx, vby, _mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+		for(; i < n; i++)
+			out[i] = area(ax, ay, bx, by, x[i], y[i]);
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static int firstLeftSSE2(double ax, double ay, double bx, double by, const double *x, const double *y, int begin, int end)
+	{
+		int i = begin;
+		for(; i + 2 <= end; i += 2)
+		{
+			int mask = leftSSE2(ax, ay, bx, by, _mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+			if(mask)
+				return i + __builtin_ctz(mask);
+		}
+		return firstLeftScalar(ax, ay, bx, by, x, y, i, end);
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static int selectLeftSSE2(double ax, double ay, double bx, double by, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		if(index)								//gathering is not worth it with SSE2
+			return selectLeftScalar(ax, ay, bx, by, x, y, index, n, out);
+		int i = 0, count = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			int mask = leftSSE2(ax, ay, bx, by, _mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+			out[count] = i;
+			count += mask & 1;
+			out[count] = i + 1;
+			count += mask >> 1;
+		}
+		for(; i < n; i++)
+			if(turn(ax, ay, bx, by, x[i], y[i]) > 0)
+				out[count++] = i;
+		return count;
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static int selectOutsideSSE2(const double *px, const double *py, int m, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		if(index)
+			return selectOutsideScalar(px, py, m, x, y, index, n, out);
+		__m128d bound = _mm_set1_pd(INSIDE_BOUND), sign = _mm_set1_pd(-0.0);
+		int i = 0, count = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			__m128d cx = _mm_loadu_pd(x + i), cy = _mm_loadu_pd(y + i);
+			int inside = 3;
+			for(int k = 0; k < m; k++)
+			{
+				int l = (k + 1) % m;
+				__m128d left = _mm_mul_pd(_mm_set1_pd(px[l] - px[k]), _mm_sub_pd(cy, _mm_set1_pd(py[k])));
+				__m128d right = _mm_mul_pd(_mm_set1_pd(py[l] - py[k]), _mm_sub_pd(cx, _mm_set1_pd(px[k])));
+				__m128d error = _mm_mul_pd(bound, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+				inside &= _mm_movemask_pd(_mm_cmpgt_pd(_mm_sub_pd(left, right), error));
+			}
+			out[count] = i;
+			count += !(inside & 1);
+			out[count] = i + 1;
+			count += !(inside & 2);
+		}
+		for(; i < n; i++)
+		{
+			out[count] = i;
+			count += !strictlyInside(px, py, m, x[i], y[i]);
+		}
+		return count;
+	}
+
+/**
+  *\var struct Compaction
+  *\brief The byte shuffles which move the selected 32 bit lanes of a mask to the front, one for each of the 16 masks.
+  */
+private:
+	struct Compaction
+	{
+		unsigned char table[16][16];
+		Compaction()
+		{
+			for(int mask = 0; mask < 16; mask++)
+			{
+				int count = 0;
+				for(int lane = 0; lane < 4; lane++)
+					if(mask >> lane & 1)
+					{
+						for(int byte = 0; byte < 4; byte++)
+							table[mask][4 * count + byte] = 4 * lane + byte;
+						count++;
+					}
+				for(int byte = 4 * count; byte < 16; byte++)
+					table[mask][byte] = 0x80;		//zero the unused lanes
+			}
+		}
+	};
+
+private:
+	static const Compaction &compaction(void)
+	{
+		static const Compaction table;
+		return table;
+	}
+
+/**
+  *AVX2 versions of the batch functions, four points at a time.
+  *The same expression as in areaSSE2 is used, fused multiply add is not enabled so the results do not change.
+  */
+private:
+	__attribute__((target("avx2")))
+	static __m256d areaAVX2(__m256d ab, __m256d ax, __m256d ay, __m256d bx, __m256d by, __m256d cx, __m256d cy)
+	{
+		__m256d t = _mm256_add_pd(ab, _mm256_mul_pd(bx, cy));
+		t = _mm256_sub_pd(t, _mm256_mul_pd(cx, by));
+		t = _mm256_add_pd(t, _mm256_mul_pd(cx, ay));
+		return _mm256_sub_pd(t, _mm256_mul_pd(ax, cy));
+	}
+
+/**
+  *\fn static int leftAVX2(double ax, double ay, double bx, double by, __m256d cx, __m256d cy)
+  *\return the mask of the four points which are on the left of ab
+  *
+  *\brief The filter of turn on four points, like leftSSE2.
+  */
+private:
+	__attribute__((target("avx2")))
+	static int leftAVX2(double ax, double ay, double bx, double by, __m256d cx, __m256d cy)
+	{
+		__m256d sign = _mm256_set1_pd(-0.0);
+		__m256d left = _mm256_mul_pd(_mm256_set1_pd(bx - ax), _mm256_sub_pd(cy, _mm256_set1_pd(ay)));
+		__m256d right = _mm256_mul_pd(_mm256_set1_pd(by - ay), _mm256_sub_pd(cx, _mm256_set1_pd(ax)));
+		__m256d det = _mm256_sub_pd(left, right);
+		__m256d bound = _mm256_mul_pd(_mm256_set1_pd(ERROR_A), _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+		int mask = _mm256_movemask_pd(_mm256_cmp_pd(det, _mm256_setzero_pd(), _CMP_GT_OQ));
+		int unsure = ~_mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, det), bound, _CMP_GE_OQ)) & 15;
+		if(unsure)
+		{
+			double px[4], py[4];
+			_mm256_storeu_pd(px, cx);
+			_mm256_storeu_pd(py, cy);
+			for(int lane = 0; lane < 4; lane++)
+				if(unsure >> lane & 1)
+					mask = (mask & ~(1 << lane)) | (turn(ax, ay, bx, by, px[lane], py[lane]) > 0) << lane;
+		}
+		return mask;
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static void areasAVX2(double ax, double ay, double bx, double by, const double *x, const double *y, int n, double *out)
+	{
+		__m256d vab = _mm256_set1_pd(ax * by - bx * ay);
+		__m256d vax = _mm256_set1_pd(ax), vay = _mm256_set1_pd(ay), vbx = _mm256_set1_pd(bx), vby = _mm256_set1_pd(by);
+		int i = 0;
+		for(; i + 4 <= n; i += 4)
+			_mm256_storeu_pd(out + i, areaAVX2(vab, vax, vay, vbx, vby, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+		for(; i < n; i++)
+			out[i] = area(ax, ay, bx, by, x[i], y[i]);
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static int firstLeftAVX2(double ax, double ay, double bx, double by, const double *x, const double *y, int begin, int end)
+	{
+		int i = begin;
+		for(; i + 8 <= end; i += 8)				//two blocks per iteration to hide the latency
+		{
+			int mask = leftAVX2(ax, ay, bx, by, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+			mask |= leftAVX2(ax, ay, bx, by, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)) << 4;
+			if(mask)
+				return i + __builtin_ctz(mask);
+		}
+		return firstLeftScalar(ax, ay, bx, by, x, y, i, end);
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static int selectLeftAVX2(double ax, double ay, double bx, double by, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		int i = 0, count = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			__m256d cx, cy;
+			__m128i j;
+			if(index)
+			{
+				j = _mm_loadu_si128((const __m128i *)(index + i));
+				__m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+				cx = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j, all, 8);
+				cy = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), y, j, all, 8);
+			}
+			else
+			{
+				j = _mm_add_epi32(_mm_set1_epi32(i), _mm_setr_epi32(0, 1, 2, 3));
+				cx = _mm256_loadu_pd(x + i);
+				cy = _mm256_loadu_pd(y + i);
+			}
+			int mask = leftAVX2(ax, ay, bx, by, cx, cy);
+			//move the selected lanes to the front and store all four, out may alias index as count <= i
+			_mm_storeu_si128((__m128i *)(out + count), _mm_shuffle_epi8(j, _mm_loadu_si128((const __m128i *)compaction().table[mask])));
+			count += __builtin_popcount(mask);
+		}
+		for(; i < n; i++)
+		{
+			int j = index ? index[i] : i;
+			if(turn(ax, ay, bx, by, x[j], y[j]) > 0)
+				out[count++] = j;
+		}
+		return count;
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static int selectOutsideAVX2(const double *px, const double *py, int m, const double *x, const double *y, const int *index, int n, int *out)
+	{
+		__m256d zero = _mm256_setzero_pd(), bound = _mm256_set1_pd(INSIDE_BOUND), sign = _mm256_set1_pd(-0.0);
+		__m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		int i = 0, count = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			__m256d cx, cy;
+			__m128i j;
+			if(index)
+			{
+				j = _mm_loadu_si128((const __m128i *)(index + i));
+				cx = _mm256_mask_i32gather_pd(zero, x, j, all, 8);
+				cy = _mm256_mask_i32gather_pd(zero, y, j, all, 8);
+			}
+			else
+			{
+				j = _mm_add_epi32(_mm_set1_epi32(i), _mm_setr_epi32(0, 1, 2, 3));
+				cx = _mm256_loadu_pd(x + i);
+				cy = _mm256_loadu_pd(y + i);
+			}
+			__m256d inside = all;
+			for(int k = 0; k < m; k++)
+			{
+				int l = (k + 1) % m;
+				__m256d left = _mm256_mul_pd(_mm256_set1_pd(px[l] - px[k]), _mm256_sub_pd(cy, _mm256_set1_pd(py[k])));
+				__m256d right = _mm256_mul_pd(_mm256_set1_pd(py[l] - py[k]), _mm256_sub_pd(cx, _mm256_set1_pd(px[k])));
+				__m256d error = _mm256_mul_pd(bound, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+				inside = _mm256_and_pd(inside, _mm256_cmp_pd(_mm256_sub_pd(left, right), error, _CMP_GT_OQ));
+			}
+			int mask = ~_mm256_movemask_pd(inside) & 15;
+			_mm_storeu_si128((__m128i *)(out + count), _mm_shuffle_epi8(j, _mm_loadu_si128((const __m128i *)compaction().table[mask])));
+			count += __builtin_popcount(mask);
+		}
+		for(; i < n; i++)
+		{
+			int j = index ? index[i] : i;
+			out[count] = j;
+			count += !strictlyInside(px, py, m, x[j], y[j]);
+		}
+		return count;
+	}
+#endif
+};
@@ -3,7 +3,7 @@
   *\author: Gurleen Cheema
   *
   *\brief: A class having functions to convert set of points from planar to spherical co-ordinates.
-  * 
+  *
   *\warning: compile it with c++11 or later version for best results
   *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
   *\warning: All the angles would be stored in degrees.
@@ -12,6 +12,11 @@
   *The user has options to provide the new origin and the direction.
   *The point has to be provided as a Point class and the direction as Line class.
   *
+  *The batch functions convert a PointSetView into arrays given by the caller, in double or in float.
+  *The direction is turned into a unit vector once, and every point is rotated by it, so theta is the angle of the rotated point.
+  *The angles are computed with a polynomial approximation of atan2, which has a scalar, an SSE2 and an AVX2 version like Orientation.
+  *All versions evaluate the same expressions in the same order, so they give exactly the same results.
+  *The double version is accurate to a few units in the last place, the float version to about 5e-5 degrees.
   */
 class PlanarToSpherical
 {
@@ -29,22 +34,12 @@ public:
   *Time complexity is O(n)
   *Returns a new vector with spherical points stored in it.
   *Order is maintained.
+  *The radius is the distance in the plane and phi is zero, use convert3D for points in 3 dimensions.
   *
   */
 	static vector<SphericalPoint> convert(vector<Point> input, Point origin, Line direction)
 	{
-		vector<SphericalPoint> result;			//create a vector to store the result
-		double radius, theta, phi;
-		for(Point p : input)					//iterate over all the points
-		{
-			radius = pow(pow(p.x - origin.x, 2) + pow(p.y - origin.y, 2), .5);		//set the radius as distance
-			theta = getAngle(origin, direction, p);		//theta as the angle
-			SphericalPoint sp;					//create an instance of spherical point
-			sp.radius = radius;					//set the values
-			sp.theta = theta;
-			result.push_back(sp);				//push it in the vector
-		}
-		return result;
+		return convertPoints(input, origin, direction, false);
 	}
 
 public:
@@ -65,7 +60,7 @@ public:
   */
 	static vector<SphericalPoint> convert(vector<Point> input, Point origin)
 	{
-		return convert(input, origin, *(new Line(0,0,0,1,0,0)));
+		return convert(input, origin, Line(0,0,0,1,0,0));
 	}
 
 public:
@@ -86,40 +81,567 @@ public:
   */
 	static vector<SphericalPoint> convert(vector<Point> input)
 	{
-		return convert(input, *(new Point(0,0,0)), *(new Line(0,0,0,1,0,0)));
+		return convert(input, Point(0,0,0), Line(0,0,0,1,0,0));
 	}
 
-private:
+public:
 /**
-  *\fn static double getAngle(Point pivot, Line direction, Point p)
-  *\param Point pivot
+  *\fn static vector<SphericalPoint> convert3D(vector<Point> input, Point origin, Line direction)
+  *\param vector<Point> input
+  *\param Point origin
   *\param Line direction
-  *\param Point p
-  *\return double angle
+  *\return a vector of SphericalPoint
   *
-  *\brief Get a angle of a point from a given line at a given point.
+  *\brief A function to convert a vector of points in 3 dimensions to spherical points.
+  *
+  *The radius is the distance to origin, theta is measured in the xy plane from direction like in convert,
+  *and phi is the angle from the z axis, from 0 to 180 degrees.
+  *Time complexity is O(n)
   *
-  *The angle would be measure in degrees.
-  *The value would lie in between 0degree to 360degrees.
   */
-	static double getAngle(Point pivot, Line direction, Point p)
+	static vector<SphericalPoint> convert3D(vector<Point> input, Point origin, Line direction)
 	{
-		//first move the direction vector to origin
-		if(direction.start.x != pivot.x || direction.start.y != pivot.y)
+		return convertPoints(input, origin, direction, true);
+	}
+
+public:
+/**
+  *\fn static void convert(PointSetView points, Point origin, Line direction, double *radius, double *theta, double *phi)
+  *\param PointSetView points
+  *\param Point origin
+  *\param Line direction
+  *\param double *radius, *theta arrays of points.size numbers for the result
+  *\param double *phi an array for the angles from the z axis, or NULL
+  *
+  *\brief A batch function to convert a set of points into arrays, without creating a SphericalPoint for every point.
+  *
+  *If phi is NULL the points are planar and radius is the distance in the xy plane, like convert above.
+  *Otherwise radius is the distance in 3 dimensions and phi is filled, a view without z has all its points at z = 0.
+  *The angles are in degrees, theta from 0 to less than 360 and phi from 0 to 180.
+  *The theta of origin itself is 0, and so is the theta of every point on the ray of direction, within the rounding error of the rotation.
+  *
+  */
+public:
+	static void convert(PointSetView points, Point origin, Line direction, double *radius, double *theta, double *phi = NULL)
+	{
+		kernels().toDouble(points, makeFrame(origin, direction), radius, theta, phi);
+	}
+
+/**
+  *\fn static void convert(PointSetView points, Point origin, Line direction, float *radius, float *theta, float *phi)
+  *
+  *\brief The same as the function above with the results in float, twice as many points at a time.
+  *
+  *The differences to origin are taken in double and then rounded to float, so the co-ordinates may be large
+  *as long as the distances fit in a float.
+  */
+public:
+	static void convert(PointSetView points, Point origin, Line direction, float *radius, float *theta, float *phi = NULL)
+	{
+		kernels().toFloat(points, makeFrame(origin, direction), radius, theta, phi);
+	}
+
+public:
+/**
+  *\fn static Orientation::Kernel getKernel(void)
+  *\return the kernel used by the batch functions
+  */
+	static Orientation::Kernel getKernel(void)
+	{
+		return kernels().kernel;
+	}
+
+public:
+/**
+  *\fn static bool setKernel(Orientation::Kernel kernel)
+  *\param Orientation::Kernel kernel
+  *\return false if the kernel is not supported on this machine
+  *
+  *\brief Force a version of the batch functions, mostly for testing and benchmarking.
+  *
+  *It is not safe to call it while other threads use the batch functions.
+  */
+	static bool setKernel(Orientation::Kernel kernel)
+	{
+		if(!Orientation::isSupported(kernel))
+			return false;
+		kernels() = makeTable(kernel);
+		return true;
+	}
+
+/**
+  *\fn static vector<SphericalPoint> convertPoints(const vector<Point> &input, Point origin, Line direction, bool withPhi)
+  *
+  *\brief Copy the points into arrays, convert them with the batch function and build the SphericalPoints.
+  */
+private:
+	static vector<SphericalPoint> convertPoints(const vector<Point> &input, Point origin, Line direction, bool withPhi)
+	{
+		int n = input.size();
+		vector<double> x(n), y(n), z(n), radius(n), theta(n), phi(withPhi ? n : 0);
+		for(int iter = 0; iter < n; iter++)
 		{
-			direction.end.x -= (direction.start.x - pivot.x);
-			direction.end.y -= (direction.start.y - pivot.y);
-			direction.start.x = pivot.x;
-			direction.start.y = pivot.y;
+			x[iter] = input[iter].x;
+			y[iter] = input[iter].y;
+			z[iter] = input[iter].z;
 		}
+		convert(PointSetView(x.data(), y.data(), z.data(), n), origin, direction, radius.data(), theta.data(), withPhi ? phi.data() : NULL);
+		vector<SphericalPoint> result;
+		result.reserve(n);
+		for(int iter = 0; iter < n; iter++)
+			result.push_back(SphericalPoint(radius[iter], theta[iter], withPhi ? phi[iter] : 0.0));
+		return result;
+	}
+
+/**
+  *\var struct Frame
+  *\brief The origin and the unit vector (c, s) of the direction.
+  *
+  *A point at (dx, dy) from the origin is rotated to (dx * c + dy * s, dy * c - dx * s), whose angle is theta.
+  */
+private:
+	struct Frame
+	{
+		double ox, oy, oz, c, s;
+	};
+
+private:
+	static Frame makeFrame(const Point &origin, const Line &direction)
+	{
+		Frame frame;
+		frame.ox = origin.x;
+		frame.oy = origin.y;
+		frame.oz = origin.z;
+		double dx = direction.end.x - direction.start.x, dy = direction.end.y - direction.start.y;
+		double length = sqrt(dx * dx + dy * dy);
+		frame.c = length > 0 ? dx / length : 1;		//an empty direction is the x axis
+		frame.s = length > 0 ? dy / length : 0;
+		return frame;
+	}
 
-		double angle1 = atan2(direction.end.y - pivot.y, direction.end.x - pivot.x);	//slop of direction vector
-    	double angle2 = atan2(p.y - pivot.y, p.x - pivot.x);		//slope of origin and point
-    	double angle = angle1 - angle2;
-    	angle = angle * -1;							//required
-    	angle = angle * 180 / 3.14159265;			//for conversion to degrees
-    	if(angle < 0)
-    		angle = angle + 360;					//to ensure angle is positive
-    	return angle;
+/**
+  *\var struct Table
+  *\brief The batch functions currently used, picked once at the first call.
+  */
+private:
+	struct Table
+	{
+		Orientation::Kernel kernel;
+		void (*toDouble)(const PointSetView &, const Frame &, double *, double *, double *);
+		void (*toFloat)(const PointSetView &, const Frame &, float *, float *, float *);
+	};
+
+private:
+	static Table &kernels(void)
+	{
+		static Table table = detect();
+		return table;
+	}
+
+private:
+	static Table detect(void)
+	{
+		if(Orientation::isSupported(Orientation::AVX2))
+			return makeTable(Orientation::AVX2);
+		if(Orientation::isSupported(Orientation::SSE2))
+			return makeTable(Orientation::SSE2);
+		return makeTable(Orientation::SCALAR);
+	}
+
+private:
+	static Table makeTable(Orientation::Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		if(kernel == Orientation::AVX2)
+			return {Orientation::AVX2, toDoubleAVX2, toFloatAVX2};
+		if(kernel == Orientation::SSE2)
+			return {Orientation::SSE2, toDoubleSSE2, toFloatSSE2};
+#endif
+		return {Orientation::SCALAR, toDoubleScalar, toFloatScalar};
+	}
+
+/**
+  *\var constants of the approximation
+  *\brief The rational approximation of atan of the Cephes library for double, and its polynomial for float.
+  *
+  *The double one is used on [0, 0.66] and the float one on [0, tan(pi / 8)],
+  *a larger ratio t is reduced with atan(t) = pi / 4 + atan((t - 1) / (t + 1)).
+  */
+private:
+	static constexpr double P0 = -8.750608600031904122785e-1, P1 = -1.615753718733365076637e1, P2 = -7.500855792314704667340e1,
+		P3 = -1.228866684490136173410e2, P4 = -6.485021904942025371773e1;
+	static constexpr double Q0 = 2.485846490142306297962e1, Q1 = 1.650270098316988542046e2, Q2 = 4.328810604912902668951e2,
+		Q3 = 4.853903996359136964868e2, Q4 = 1.945506571482613964425e2;
+	static constexpr double REDUCE = 0.66;
+	static constexpr float F0 = 8.05374449538e-2f, F1 = -1.38776856032e-1f, F2 = 1.99777106478e-1f, F3 = -3.33329491539e-1f;
+	static constexpr float REDUCE_FLOAT = 0.4142135623730950f;
+	static constexpr double PI = 3.14159265358979323846, DEGREES = 180 / PI;
+
+/**
+  *\var static constexpr double RAY_ERROR, RAY_ERROR_FLOAT
+  *\brief A bound on the rounding error of the rotated v, relative to |dy * c| + |dx * s|.
+  *
+  *A point with u > 0 and |v| below it is on the ray of the direction, e.g. the point which gave the direction, and its theta is exactly 0.
+  *Otherwise a v of -1e-17 would give a theta of 360 and the point would be sorted last instead of first.
+  */
+	static constexpr double RAY_ERROR = 8 * 1.1102230246251565e-16;
+	static constexpr float RAY_ERROR_FLOAT = 8 * 5.9604645e-08f;
+
+/**
+  *\fn static double halfAngle(double v, double u)
+  *\param double v at least zero
+  *\param double u
+  *\return atan2(v, u) from 0 to pi
+  *
+  *\brief The angle of (u, v) from the smaller of |u| and |v| divided by the larger one.
+  *
+  *The result is corrected for v > |u| and for u < 0, a negative v is handled by the caller.
+  */
+private:
+	static double halfAngle(double v, double u)
+	{
+		double au = fabs(u);
+		double big = au > v ? au : v, small = au > v ? v : au;
+		double t = small / (big == 0 ? 1.0 : big);
+		bool reduce = t > REDUCE;
+		double x = reduce ? (t - 1) / (t + 1) : t;
+		double z = x * x;
+		double p = (((P0 * z + P1) * z + P2) * z + P3) * z + P4;
+		double q = ((((z + Q0) * z + Q1) * z + Q2) * z + Q3) * z + Q4;
+		double a = x * (z * p / q) + x;
+		a = a + (reduce ? PI / 4 : 0.0);
+		a = v > au ? PI / 2 - a : a;
+		return u < 0 ? PI - a : a;
+	}
+
+private:
+	static float halfAngle(float v, float u)
+	{
+		float au = fabsf(u);
+		float big = au > v ? au : v, small = au > v ? v : au;
+		float t = small / (big == 0 ? 1.0f : big);
+		bool reduce = t > REDUCE_FLOAT;
+		float x = reduce ? (t - 1) / (t + 1) : t;
+		float z = x * x;
+		float a = (((F0 * z + F1) * z + F2) * z + F3) * z * x + x;
+		a = a + (reduce ? (float)(PI / 4) : 0.0f);
+		a = v > au ? (float)(PI / 2) - a : a;
+		return u < 0 ? (float)PI - a : a;
+	}
+
+/**
+  *Scalar versions of the batch functions.
+  */
+private:
+	static void toDoubleScalar(const PointSetView &points, const Frame &f, double *radius, double *theta, double *phi)
+	{
+		for(int i = 0; i < points.size; i++)
+		{
+			double dx = points.x[i] - f.ox, dy = points.y[i] - f.oy;
+			double dyc = dy * f.c, dxs = dx * f.s;
+			double u = dx * f.c + dy * f.s, v = dyc - dxs;
+			double rho2 = dx * dx + dy * dy;
+			double a = halfAngle(fabs(v), u);
+			double t = (v < 0 ? 2 * PI - a : a) * DEGREES;
+			bool ray = u > 0 && fabs(v) <= (fabs(dyc) + fabs(dxs)) * RAY_ERROR;
+			theta[i] = ray || t >= 360 ? 0.0 : t;				//on the ray of the direction, or wrapped around
+			if(phi == NULL)
+			{
+				radius[i] = sqrt(rho2);
+				continue;
+			}
+			double dz = (points.z ? points.z[i] : 0.0) - f.oz;
+			radius[i] = sqrt(rho2 + dz * dz);
+			phi[i] = halfAngle(sqrt(rho2), dz) * DEGREES;
+		}
+	}
+
+private:
+	static void toFloatScalar(const PointSetView &points, const Frame &f, float *radius, float *theta, float *phi)
+	{
+		float c = f.c, s = f.s;
+		for(int i = 0; i < points.size; i++)
+		{
+			float dx = points.x[i] - f.ox, dy = points.y[i] - f.oy;
+			float dyc = dy * c, dxs = dx * s;
+			float u = dx * c + dy * s, v = dyc - dxs;
+			float rho2 = dx * dx + dy * dy;
+			float a = halfAngle(fabsf(v), u);
+			float t = (v < 0 ? (float)(2 * PI) - a : a) * (float)DEGREES;
+			bool ray = u > 0 && fabsf(v) <= (fabsf(dyc) + fabsf(dxs)) * RAY_ERROR_FLOAT;
+			theta[i] = ray || t >= 360 ? 0.0f : t;
+			if(phi == NULL)
+			{
+				radius[i] = sqrtf(rho2);
+				continue;
+			}
+			float dz = (points.z ? points.z[i] : 0.0) - f.oz;
+			radius[i] = sqrtf(rho2 + dz * dz);
+			phi[i] = halfAngle(sqrtf(rho2), dz) * (float)DEGREES;
+		}
+	}
+
+#ifdef CGEO_X86_SIMD
+/**
+  *SSE2 versions of the batch functions, two doubles or four floats at a time.
+  *SSE2 has no blend, so a lane is selected with and, andnot and or.
+  */
+private:
+	__attribute__((target("sse2")))
+	static __m128d selectSSE2(__m128d mask, __m128d a, __m128d b)
+	{
+		return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+	}
+
+	__attribute__((target("sse2")))
+	static __m128 selectSSE2(__m128 mask, __m128 a, __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static __m128d halfAngleSSE2(__m128d v, __m128d u)
+	{
+		__m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+		__m128d au = _mm_andnot_pd(_mm_set1_pd(-0.0), u);
+		__m128d larger = _mm_cmpgt_pd(au, v);
+		__m128d big = selectSSE2(larger, au, v), small = selectSSE2(larger, v, au);
+		__m128d t = _mm_div_pd(small, selectSSE2(_mm_cmpeq_pd(big, zero), one, big));
+		__m128d reduce = _mm_cmpgt_pd(t, _mm_set1_pd(REDUCE));
+		__m128d x = selectSSE2(reduce, _mm_div_pd(_mm_sub_pd(t, one), _mm_add_pd(t, one)), t);
+		__m128d z = _mm_mul_pd(x, x);
+		__m128d p = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(P0), z), _mm_set1_pd(P1));
+		p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(P2));
+		p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(P3));
+		p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(P4));
+		__m128d q = _mm_add_pd(z, _mm_set1_pd(Q0));
+		q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(Q1));
+		q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(Q2));
+		q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(Q3));
+		q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(Q4));
+		__m128d a = _mm_add_pd(_mm_mul_pd(x, _mm_div_pd(_mm_mul_pd(z, p), q)), x);
+		a = _mm_add_pd(a, _mm_and_pd(reduce, _mm_set1_pd(PI / 4)));
+		a = selectSSE2(_mm_cmpgt_pd(v, au), _mm_sub_pd(_mm_set1_pd(PI / 2), a), a);
+		return selectSSE2(_mm_cmplt_pd(u, zero), _mm_sub_pd(_mm_set1_pd(PI), a), a);
+	}
+
+	__attribute__((target("sse2")))
+	static __m128 halfAngleSSE2(__m128 v, __m128 u)
+	{
+		__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+		__m128 au = _mm_andnot_ps(_mm_set1_ps(-0.0f), u);
+		__m128 larger = _mm_cmpgt_ps(au, v);
+		__m128 big = selectSSE2(larger, au, v), small = selectSSE2(larger, v, au);
+		__m128 t = _mm_div_ps(small, selectSSE2(_mm_cmpeq_ps(big, zero), one, big));
+		__m128 reduce = _mm_cmpgt_ps(t, _mm_set1_ps(REDUCE_FLOAT));
+		__m128 x = selectSSE2(reduce, _mm_div_ps(_mm_sub_ps(t, one), _mm_add_ps(t, one)), t);
+		__m128 z = _mm_mul_ps(x, x);
+		__m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(F0), z), _mm_set1_ps(F1));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(F2));
+		p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(F3));
+		__m128 a = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), x), x);
+		a = _mm_add_ps(a, _mm_and_ps(reduce, _mm_set1_ps(PI / 4)));
+		a = selectSSE2(_mm_cmpgt_ps(v, au), _mm_sub_ps(_mm_set1_ps(PI / 2), a), a);
+		return selectSSE2(_mm_cmplt_ps(u, zero), _mm_sub_ps(_mm_set1_ps(PI), a), a);
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static void toDoubleSSE2(const PointSetView &points, const Frame &f, double *radius, double *theta, double *phi)
+	{
+		const double *x = points.x, *y = points.y, *zs = points.z;
+		__m128d ox = _mm_set1_pd(f.ox), oy = _mm_set1_pd(f.oy), oz = _mm_set1_pd(f.oz), c = _mm_set1_pd(f.c), s = _mm_set1_pd(f.s);
+		__m128d sign = _mm_set1_pd(-0.0), zero = _mm_setzero_pd(), full = _mm_set1_pd(2 * PI), degrees = _mm_set1_pd(DEGREES);
+		__m128d error = _mm_set1_pd(RAY_ERROR), turn = _mm_set1_pd(360.0);
+		int n = points.size, i = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			__m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), ox), dy = _mm_sub_pd(_mm_loadu_pd(y + i), oy);
+			__m128d dyc = _mm_mul_pd(dy, c), dxs = _mm_mul_pd(dx, s);
+			__m128d u = _mm_add_pd(_mm_mul_pd(dx, c), _mm_mul_pd(dy, s)), v = _mm_sub_pd(dyc, dxs);
+			__m128d rho2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+			__m128d a = halfAngleSSE2(_mm_andnot_pd(sign, v), u);
+			a = selectSSE2(_mm_cmplt_pd(v, zero), _mm_sub_pd(full, a), a);
+			__m128d t = _mm_mul_pd(a, degrees);
+			__m128d bound = _mm_mul_pd(_mm_add_pd(_mm_andnot_pd(sign, dyc), _mm_andnot_pd(sign, dxs)), error);
+			__m128d ray = _mm_and_pd(_mm_cmpgt_pd(u, zero), _mm_cmple_pd(_mm_andnot_pd(sign, v), bound));
+			_mm_storeu_pd(theta + i, _mm_andnot_pd(_mm_or_pd(ray, _mm_cmpge_pd(t, turn)), t));
+			if(phi == NULL)
+			{
+				_mm_storeu_pd(radius + i, _mm_sqrt_pd(rho2));
+				continue;
+			}
+			__m128d dz = _mm_sub_pd(zs ? _mm_loadu_pd(zs + i) : zero, oz);
+			_mm_storeu_pd(radius + i, _mm_sqrt_pd(_mm_add_pd(rho2, _mm_mul_pd(dz, dz))));
+			_mm_storeu_pd(phi + i, _mm_mul_pd(halfAngleSSE2(_mm_sqrt_pd(rho2), dz), degrees));
+		}
+		toDoubleScalar(points.slice(i, n), f, radius + i, theta + i, phi ? phi + i : NULL);
+	}
+
+private:
+	__attribute__((target("sse2")))
+	static void toFloatSSE2(const PointSetView &points, const Frame &f, float *radius, float *theta, float *phi)
+	{
+		const double *x = points.x, *y = points.y, *zs = points.z;
+		__m128d ox = _mm_set1_pd(f.ox), oy = _mm_set1_pd(f.oy), oz = _mm_set1_pd(f.oz), zerod = _mm_setzero_pd();
+		__m128 c = _mm_set1_ps(f.c), s = _mm_set1_ps(f.s);
+		__m128 sign = _mm_set1_ps(-0.0f), zero = _mm_setzero_ps(), full = _mm_set1_ps(2 * PI), degrees = _mm_set1_ps(DEGREES);
+		__m128 error = _mm_set1_ps(RAY_ERROR_FLOAT), turn = _mm_set1_ps(360.0f);
+		int n = points.size, i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			__m128 dx = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(x + i), ox)), _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(x + i + 2), ox)));
+			__m128 dy = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(y + i), oy)), _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(y + i + 2), oy)));
+			__m128 dyc = _mm_mul_ps(dy, c), dxs = _mm_mul_ps(dx, s);
+			__m128 u = _mm_add_ps(_mm_mul_ps(dx, c), _mm_mul_ps(dy, s)), v = _mm_sub_ps(dyc, dxs);
+			__m128 rho2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			__m128 a = halfAngleSSE2(_mm_andnot_ps(sign, v), u);
+			a = selectSSE2(_mm_cmplt_ps(v, zero), _mm_sub_ps(full, a), a);
+			__m128 t = _mm_mul_ps(a, degrees);
+			__m128 bound = _mm_mul_ps(_mm_add_ps(_mm_andnot_ps(sign, dyc), _mm_andnot_ps(sign, dxs)), error);
+			__m128 ray = _mm_and_ps(_mm_cmpgt_ps(u, zero), _mm_cmple_ps(_mm_andnot_ps(sign, v), bound));
+			_mm_storeu_ps(theta + i, _mm_andnot_ps(_mm_or_ps(ray, _mm_cmpge_ps(t, turn)), t));
+			if(phi == NULL)
+			{
+				_mm_storeu_ps(radius + i, _mm_sqrt_ps(rho2));
+				continue;
+			}
+			__m128 dz = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(zs ? _mm_loadu_pd(zs + i) : zerod, oz)),
+				_mm_cvtpd_ps(_mm_sub_pd(zs ? _mm_loadu_pd(zs + i + 2) : zerod, oz)));
+			_mm_storeu_ps(radius + i, _mm_sqrt_ps(_mm_add_ps(rho2, _mm_mul_ps(dz, dz))));
+			_mm_storeu_ps(phi + i, _mm_mul_ps(halfAngleSSE2(_mm_sqrt_ps(rho2), dz), degrees));
+		}
+		toFloatScalar(points.slice(i, n), f, radius + i, theta + i, phi ? phi + i : NULL);
+	}
+
+/**
+  *AVX2 versions of the batch functions, four doubles or eight floats at a time.
+  *Fused multiply add is not enabled so the results are the same as the other versions.
+  */
+private:
+	__attribute__((target("avx2")))
+	static __m256d halfAngleAVX2(__m256d v, __m256d u)
+	{
+		__m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+		__m256d au = _mm256_andnot_pd(_mm256_set1_pd(-0.0), u);
+		__m256d larger = _mm256_cmp_pd(au, v, _CMP_GT_OQ);
+		__m256d big = _mm256_blendv_pd(v, au, larger), small = _mm256_blendv_pd(au, v, larger);
+		__m256d t = _mm256_div_pd(small, _mm256_blendv_pd(big, one, _mm256_cmp_pd(big, zero, _CMP_EQ_OQ)));
+		__m256d reduce = _mm256_cmp_pd(t, _mm256_set1_pd(REDUCE), _CMP_GT_OQ);
+		__m256d x = _mm256_blendv_pd(t, _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one)), reduce);
+		__m256d z = _mm256_mul_pd(x, x);
+		__m256d p = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(P0), z), _mm256_set1_pd(P1));
+		p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(P2));
+		p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(P3));
+		p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(P4));
+		__m256d q = _mm256_add_pd(z, _mm256_set1_pd(Q0));
+		q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(Q1));
+		q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(Q2));
+		q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(Q3));
+		q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(Q4));
+		__m256d a = _mm256_add_pd(_mm256_mul_pd(x, _mm256_div_pd(_mm256_mul_pd(z, p), q)), x);
+		a = _mm256_add_pd(a, _mm256_and_pd(reduce, _mm256_set1_pd(PI / 4)));
+		a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(PI / 2), a), _mm256_cmp_pd(v, au, _CMP_GT_OQ));
+		return _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(PI), a), _mm256_cmp_pd(u, zero, _CMP_LT_OQ));
+	}
+
+	__attribute__((target("avx2")))
+	static __m256 halfAngleAVX2(__m256 v, __m256 u)
+	{
+		__m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+		__m256 au = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), u);
+		__m256 larger = _mm256_cmp_ps(au, v, _CMP_GT_OQ);
+		__m256 big = _mm256_blendv_ps(v, au, larger), small = _mm256_blendv_ps(au, v, larger);
+		__m256 t = _mm256_div_ps(small, _mm256_blendv_ps(big, one, _mm256_cmp_ps(big, zero, _CMP_EQ_OQ)));
+		__m256 reduce = _mm256_cmp_ps(t, _mm256_set1_ps(REDUCE_FLOAT), _CMP_GT_OQ);
+		__m256 x = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, one), _mm256_add_ps(t, one)), reduce);
+		__m256 z = _mm256_mul_ps(x, x);
+		__m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(F0), z), _mm256_set1_ps(F1));
+		p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(F2));
+		p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(F3));
+		__m256 a = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, z), x), x);
+		a = _mm256_add_ps(a, _mm256_and_ps(reduce, _mm256_set1_ps(PI / 4)));
+		a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(PI / 2), a), _mm256_cmp_ps(v, au, _CMP_GT_OQ));
+		return _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(PI), a), _mm256_cmp_ps(u, zero, _CMP_LT_OQ));
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static void toDoubleAVX2(const PointSetView &points, const Frame &f, double *radius, double *theta, double *phi)
+	{
+		const double *x = points.x, *y = points.y, *zs = points.z;
+		__m256d ox = _mm256_set1_pd(f.ox), oy = _mm256_set1_pd(f.oy), oz = _mm256_set1_pd(f.oz), c = _mm256_set1_pd(f.c), s = _mm256_set1_pd(f.s);
+		__m256d sign = _mm256_set1_pd(-0.0), zero = _mm256_setzero_pd(), full = _mm256_set1_pd(2 * PI), degrees = _mm256_set1_pd(DEGREES);
+		__m256d error = _mm256_set1_pd(RAY_ERROR), turn = _mm256_set1_pd(360.0);
+		int n = points.size, i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), ox), dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), oy);
+			__m256d dyc = _mm256_mul_pd(dy, c), dxs = _mm256_mul_pd(dx, s);
+			__m256d u = _mm256_add_pd(_mm256_mul_pd(dx, c), _mm256_mul_pd(dy, s)), v = _mm256_sub_pd(dyc, dxs);
+			__m256d rho2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+			__m256d a = halfAngleAVX2(_mm256_andnot_pd(sign, v), u);
+			a = _mm256_blendv_pd(a, _mm256_sub_pd(full, a), _mm256_cmp_pd(v, zero, _CMP_LT_OQ));
+			__m256d t = _mm256_mul_pd(a, degrees);
+			__m256d bound = _mm256_mul_pd(_mm256_add_pd(_mm256_andnot_pd(sign, dyc), _mm256_andnot_pd(sign, dxs)), error);
+			__m256d ray = _mm256_and_pd(_mm256_cmp_pd(u, zero, _CMP_GT_OQ), _mm256_cmp_pd(_mm256_andnot_pd(sign, v), bound, _CMP_LE_OQ));
+			_mm256_storeu_pd(theta + i, _mm256_andnot_pd(_mm256_or_pd(ray, _mm256_cmp_pd(t, turn, _CMP_GE_OQ)), t));
+			if(phi == NULL)
+			{
+				_mm256_storeu_pd(radius + i, _mm256_sqrt_pd(rho2));
+				continue;
+			}
+			__m256d dz = _mm256_sub_pd(zs ? _mm256_loadu_pd(zs + i) : zero, oz);
+			_mm256_storeu_pd(radius + i, _mm256_sqrt_pd(_mm256_add_pd(rho2, _mm256_mul_pd(dz, dz))));
+			_mm256_storeu_pd(phi + i, _mm256_mul_pd(halfAngleAVX2(_mm256_sqrt_pd(rho2), dz), degrees));
+		}
+		toDoubleScalar(points.slice(i, n), f, radius + i, theta + i, phi ? phi + i : NULL);
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static void toFloatAVX2(const PointSetView &points, const Frame &f, float *radius, float *theta, float *phi)
+	{
+		const double *x = points.x, *y = points.y, *zs = points.z;
+		__m256d ox = _mm256_set1_pd(f.ox), oy = _mm256_set1_pd(f.oy), oz = _mm256_set1_pd(f.oz), zerod = _mm256_setzero_pd();
+		__m256 c = _mm256_set1_ps(f.c), s = _mm256_set1_ps(f.s);
+		__m256 sign = _mm256_set1_ps(-0.0f), zero = _mm256_setzero_ps(), full = _mm256_set1_ps(2 * PI), degrees = _mm256_set1_ps(DEGREES);
+		__m256 error = _mm256_set1_ps(RAY_ERROR_FLOAT), turn = _mm256_set1_ps(360.0f);
+		int n = points.size, i = 0;
+		for(; i + 8 <= n; i += 8)
+		{
+			__m256 dx = toFloatAVX2(_mm256_sub_pd(_mm256_loadu_pd(x + i), ox), _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), ox));
+			__m256 dy = toFloatAVX2(_mm256_sub_pd(_mm256_loadu_pd(y + i), oy), _mm256_sub_pd(_mm256_loadu_pd(y + i + 4), oy));
+			__m256 dyc = _mm256_mul_ps(dy, c), dxs = _mm256_mul_ps(dx, s);
+			__m256 u = _mm256_add_ps(_mm256_mul_ps(dx, c), _mm256_mul_ps(dy, s)), v = _mm256_sub_ps(dyc, dxs);
+			__m256 rho2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			__m256 a = halfAngleAVX2(_mm256_andnot_ps(sign, v), u);
+			a = _mm256_blendv_ps(a, _mm256_sub_ps(full, a), _mm256_cmp_ps(v, zero, _CMP_LT_OQ));
+			__m256 t = _mm256_mul_ps(a, degrees);
+			__m256 bound = _mm256_mul_ps(_mm256_add_ps(_mm256_andnot_ps(sign, dyc), _mm256_andnot_ps(sign, dxs)), error);
+			__m256 ray = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(sign, v), bound, _CMP_LE_OQ));
+			_mm256_storeu_ps(theta + i, _mm256_andnot_ps(_mm256_or_ps(ray, _mm256_cmp_ps(t, turn, _CMP_GE_OQ)), t));
+			if(phi == NULL)
+			{
+				_mm256_storeu_ps(radius + i, _mm256_sqrt_ps(rho2));
+				continue;
+			}
+			__m256 dz = toFloatAVX2(_mm256_sub_pd(zs ? _mm256_loadu_pd(zs + i) : zerod, oz), _mm256_sub_pd(zs ? _mm256_loadu_pd(zs + i + 4) : zerod, oz));
+			_mm256_storeu_ps(radius + i, _mm256_sqrt_ps(_mm256_add_ps(rho2, _mm256_mul_ps(dz, dz))));
+			_mm256_storeu_ps(phi + i, _mm256_mul_ps(halfAngleAVX2(_mm256_sqrt_ps(rho2), dz), degrees));
+		}
+		toFloatScalar(points.slice(i, n), f, radius + i, theta + i, phi ? phi + i : NULL);
+	}
+
+/**
+  *\brief Round two vectors of four doubles to one vector of eight floats.
+  */
+private:
+	__attribute__((target("avx2")))
+	static __m256 toFloatAVX2(__m256d low, __m256d high)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
 	}
-};
\ No newline at end of file
+#endif
+};
@@ -12,33 +12,37 @@
   *Various constructors are available to initialize the point in 1, 2 or 3 dimensions.
   *If nothing is provided, the point is assumed to be the origin of 3 dimensional space.
   *If lesses dimensions are provided, the rest are set to zero.
+  *
+  *The class is a template on the type of the co-ordinates, Point is the one with double co-ordinates which is used everywhere.
+  *BasicPoint<int> is a point on an integer grid, see BasicPointSet for the hull algorithms which are exact for such points.
   */
-class Point
+template<class T>
+class BasicPoint
 {
 /**
-  *\var double x
+  *\var T x
   *\brief the x co-ordinate of the point.
   *
-  *\var double y
+  *\var T y
   *\brief the y co-ordinate of the point.
   *
-  *\var double z
+  *\var T z
   *\brief the z co-ordinate of the point.
   */
 public:
-	double x, y, z;
+	T x, y, z;
 
 public:
 /**
-  *\param double x
-  *\param double y
-  *\param double z
+  *\param T x
+  *\param T y
+  *\param T z
   *
   *\brief A constructor to initialize the point at (x,y,z)
   *
   *It is for initializing the points in 3 dimensions.
   */
-	Point(double x, double y, double z)
+	BasicPoint(T x, T y, T z)
 	{
 		this->x = x;
 		this->y = y;
@@ -47,8 +51,8 @@ public:
 
 public:
 /**
-  *\param double x
-  *\param double y
+  *\param T x
+  *\param T y
   *
   *\brief A constructor to initialize the point at (x,y,0)
   *
@@ -56,14 +60,14 @@ public:
   *The third dimension is set to zero.
   *
   */
-	Point(double x, double y)
+	BasicPoint(T x, T y)
 	{
-		Point(x, y, 0.0);
+		BasicPoint(x, y, 0);
 	}
 
 public:
 /**
-  *\param double x
+  *\param T x
   *
   *\brief A constructor to initialize the point at (x,0,0)
   *
@@ -71,9 +75,9 @@ public:
   *The second and third dimensions are set to zero.
   *
   */
-	Point(double x)
+	BasicPoint(T x)
 	{
-		Point(x, 0.0, 0.0);
+		BasicPoint(x, 0, 0);
 	}
 
 public:
@@ -85,86 +89,108 @@ public:
   *It is initialized at x, y and z.
   *
   */
-	Point()
+	BasicPoint()
+	{
+		BasicPoint(0,0,0);
+	}
+
+public:
+/**
+  *\param const BasicPoint<U> &p
+  *
+  *\brief A constructor to convert a point with another type of co-ordinates, e.g. a point on an integer grid to a Point.
+  *
+  *The co-ordinates are converted with static_cast, so they are truncated if T is an integer type.
+  */
+	template<class U>
+	explicit BasicPoint(const BasicPoint<U> &p)
 	{
-		Point(0.0,0.0,0.0);
+		this->x = static_cast<T>(p.x);
+		this->y = static_cast<T>(p.y);
+		this->z = static_cast<T>(p.z);
 	}
 
 public:
 /**
-  *\fn void setX(double x)
-  *\param double x
+  *\fn void setX(T x)
+  *\param T x
   *
   *\brief A function to set the x co-ordinate of the point.
   *
   */
-	void setX(double x)
+	void setX(T x)
 	{
 		this->x = x;
 	}
 
 public:
 /**
-  *\fn void setY(double y)
-  *\param double y
+  *\fn void setY(T y)
+  *\param T y
   *
   *\brief A function to set the y co-ordinate of the point.
   *
   */
-	void setY(double y)
+	void setY(T y)
 	{
 		this->y = y;
 	}
 
 public:
 /**
-  *\fn void setZ(double z)
-  *\param double z
+  *\fn void setZ(T z)
+  *\param T z
   *
   *\brief A function to set the z co-ordinate of the point.
   *
   */
-	void setZ(double z)
+	void setZ(T z)
 	{
 		this->z = z;
 	}
 
 public:
 /**
-  *\fn double getX(void)
-  *\return double x
+  *\fn T getX(void)
+  *\return T x
   *
   *\brief A function to get the x co-ordinate of the point.
   *
   */
-	double getX(void)
+	T getX(void)
 	{
 		return x;
 	}
 
 public:
 /**
-  *\fn double getY(void)
-  *\return double y
+  *\fn T getY(void)
+  *\return T y
   *
   *\brief A function to get the y co-ordinate of the point.
   *
   */
-	double getY(void)
+	T getY(void)
 	{
 		return y;
 	}
 
 public:
 /**
-  *\fn double getZ(void)
-  *\return double z
+  *\fn T getZ(void)
+  *\return T z
   *
   *\brief A function to get the z co-ordinate of the point.
   *
   */
-	double getZ(void)
+	T getZ(void)
 	{
 		return z;
 	}
 };
+
+/**
+  *\var typedef BasicPoint<double> Point
+  *\brief The point with double co-ordinates, used by all the algorithms.
+  */
+typedef BasicPoint<double> Point;
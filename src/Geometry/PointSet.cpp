@@ -0,0 +1,410 @@
+/**\file: PointSet.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A container to store a set of points as separate co-ordinate arrays.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The file has two classes, PointSet and PointSetView.
+  *PointSet owns the points and stores all the x co-ordinates, all the y co-ordinates and optionally all the z co-ordinates in three contiguous arrays.
+  *PointSetView only refers to such arrays and is cheap to copy, like a span.
+  *The hull algorithms take a PointSetView so that they do not have to copy the points or read the z co-ordinates when they are not needed.
+  *Any PointSet can be passed where a PointSetView is required.
+  *
+  *Both classes are templates on the type of the co-ordinates, PointSet and PointSetView are the ones with double co-ordinates.
+  *BasicPointSet<int> stores points on an integer grid, e.g. quantized data.
+  *The hull algorithms which take a BasicPointSetView<int> test the side of a point with exact integer arithmetic and sort the points with an integer radix sort.
+  */
+template<class T>
+class BasicPointSetView
+{
+public:
+/**
+  *\var const T *x
+  *\brief the x co-ordinates of the points.
+  *
+  *\var const T *y
+  *\brief the y co-ordinates of the points.
+  *
+  *\var const T *z
+  *\brief the z co-ordinates of the points, NULL if the points are in 2 dimensions.
+  *
+  *\var int size
+  *\brief the number of points.
+  */
+	const T *x, *y, *z;
+	int size;
+
+public:
+/**
+  *\param const T *x
+  *\param const T *y
+  *\param const T *z
+  *\param int size
+  *
+  *\brief A constructor to view size points stored in the given arrays.
+  *
+  *Pass NULL as z if the points are in 2 dimensions.
+  *The arrays are not copied, so they must live longer than the view.
+  */
+	BasicPointSetView(const T *x, const T *y, const T *z, int size)
+	{
+		this->x = x;
+		this->y = y;
+		this->z = z;
+		this->size = size;
+	}
+
+public:
+/**
+  *\brief A constructor for an empty view.
+  */
+	BasicPointSetView()
+	{
+		x = y = z = NULL;
+		size = 0;
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return int size
+  *
+  *\brief Get the number of points in the view.
+  */
+	int getSize(void) const
+	{
+		return size;
+	}
+
+public:
+/**
+  *\fn bool hasZ(void) const
+  *\return true if the z co-ordinates are present
+  *
+  *\brief Check if the view has the z co-ordinates.
+  */
+	bool hasZ(void) const
+	{
+		return z != NULL;
+	}
+
+public:
+/**
+  *\fn BasicPoint<T> getPoint(int index) const
+  *\param int index
+  *\return BasicPoint<T> at that index
+  *
+  *\brief Returns a copy of the point stored at the given index.
+  *
+  *The indexing is done from 0 to n - 1.
+  *The z co-ordinate is set to zero if the view has no z co-ordinates.
+  */
+	BasicPoint<T> getPoint(int index) const
+	{
+		return BasicPoint<T>(x[index], y[index], z ? z[index] : T());
+	}
+
+public:
+/**
+  *\fn BasicPointSetView slice(int begin, int end) const
+  *\param int begin
+  *\param int end
+  *\return the view of the points from begin to end - 1
+  *
+  *\brief Get a view of a part of the points.
+  *
+  *The indices in the returned view start again from 0.
+  */
+	BasicPointSetView slice(int begin, int end) const
+	{
+		return BasicPointSetView(x + begin, y + begin, z ? z + begin : NULL, end - begin);
+	}
+};
+
+/**
+  *\var typedef BasicPointSetView<double> PointSetView
+  *\brief The view of points with double co-ordinates, taken by all the hull algorithms.
+  */
+typedef BasicPointSetView<double> PointSetView;
+
+template<class T>
+class BasicPointSet
+{
+private:
+/**
+  *\var vector<T> x
+  *\brief the x co-ordinates of all the points.
+  *
+  *\var vector<T> y
+  *\brief the y co-ordinates of all the points.
+  *
+  *\var vector<T> z
+  *\brief the z co-ordinates of all the points, empty if withZ is false.
+  *
+  *\var bool withZ
+  *\brief A boolean flag set to true if the z co-ordinates are stored.
+  */
+	vector<T> x, y, z;
+	bool withZ;
+
+public:
+/**
+  *\param bool withZ
+  *
+  *\brief A constructor for an empty set of points.
+  *
+  *Pass the bool parameter as true if the z co-ordinates have to be stored as well.
+  */
+	BasicPointSet(bool withZ)
+	{
+		this->withZ = withZ;
+	}
+
+public:
+/**
+  *\brief A constructor for an empty set of points in 2 dimensions.
+  */
+	BasicPointSet()
+	{
+		withZ = false;
+	}
+
+public:
+/**
+  *\param const vector<BasicPoint<T> > &points
+  *\param bool withZ
+  *
+  *\brief A constructor to convert a vector of points to a set.
+  *
+  *The order of the points is maintained.
+  *The z co-ordinates are dropped unless withZ is true.
+  */
+	BasicPointSet(const vector<BasicPoint<T> > &points, bool withZ = false)
+	{
+		this->withZ = withZ;
+		reserve(points.size());
+		for(const BasicPoint<T> &p : points)
+			insertAtLast(p.x, p.y, p.z);
+	}
+
+public:
+/**
+  *\fn void reserve(int n)
+  *\param int n
+  *
+  *\brief Reserve the memory for n points to avoid reallocation while inserting.
+  */
+	void reserve(int n)
+	{
+		x.reserve(n);
+		y.reserve(n);
+		if(withZ)
+			z.reserve(n);
+	}
+
+public:
+/**
+  *\fn void resize(int n)
+  *\param int n
+  *
+  *\brief Change the number of points to n, the new points are at the origin.
+  *
+  *Used to fill the arrays in place through getX(), getY() and getZ().
+  */
+	void resize(int n)
+	{
+		x.resize(n);
+		y.resize(n);
+		if(withZ)
+			z.resize(n);
+	}
+
+public:
+/**
+  *\fn void clear(void)
+  *
+  *\brief Removes all the points, the memory is kept to be filled again.
+  */
+	void clear(void)
+	{
+		x.clear();
+		y.clear();
+		z.clear();
+	}
+
+public:
+/**
+  *\fn void insertAtLast(T x, T y, T z)
+  *\param T x
+  *\param T y
+  *\param T z
+  *
+  *\brief Inserts the point (x, y, z) at the end.
+  *
+  *z is dropped if the set is in 2 dimensions.
+  */
+	void insertAtLast(T x, T y, T z)
+	{
+		this->x.push_back(x);
+		this->y.push_back(y);
+		if(withZ)
+			this->z.push_back(z);
+	}
+
+public:
+/**
+  *\fn void insertAtLast(T x, T y)
+  *\param T x
+  *\param T y
+  *
+  *\brief Inserts the point (x, y, 0) at the end.
+  */
+	void insertAtLast(T x, T y)
+	{
+		insertAtLast(x, y, T());
+	}
+
+public:
+/**
+  *\fn void insertAtLast(BasicPoint<T> p)
+  *\param BasicPoint<T> p
+  *
+  *\brief Inserts p at the end.
+  */
+	void insertAtLast(BasicPoint<T> p)
+	{
+		insertAtLast(p.x, p.y, p.z);
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return int size
+  *
+  *\brief Get the number of points in the set.
+  */
+	int getSize(void) const
+	{
+		return x.size();
+	}
+
+public:
+/**
+  *\fn bool hasZ(void) const
+  *\return true if the z co-ordinates are stored
+  *
+  *\brief Check if the set stores the z co-ordinates.
+  */
+	bool hasZ(void) const
+	{
+		return withZ;
+	}
+
+public:
+/**
+  *\fn BasicPoint<T> getPoint(int index) const
+  *\param int index
+  *\return BasicPoint<T> at that index
+  *
+  *\brief Returns a copy of the point stored at the given index.
+  *
+  *The indexing is done from 0 to n - 1.
+  */
+	BasicPoint<T> getPoint(int index) const
+	{
+		return BasicPoint<T>(x[index], y[index], withZ ? z[index] : T());
+	}
+
+public:
+/**
+  *\fn T *getX(void)
+  *\return the array of x co-ordinates
+  *
+  *\brief Get the array of the x co-ordinates to read or modify them in place.
+  *
+  *The pointer is invalidated when a point is inserted.
+  */
+	T *getX(void)
+	{
+		return x.data();
+	}
+
+public:
+/**
+  *\fn T *getY(void)
+  *\return the array of y co-ordinates
+  *
+  *\brief Get the array of the y co-ordinates to read or modify them in place.
+  *
+  *The pointer is invalidated when a point is inserted.
+  */
+	T *getY(void)
+	{
+		return y.data();
+	}
+
+public:
+/**
+  *\fn T *getZ(void)
+  *\return the array of z co-ordinates
+  *
+  *\brief Get the array of the z co-ordinates to read or modify them in place.
+  *
+  *Returns NULL if the set is in 2 dimensions.
+  *The pointer is invalidated when a point is inserted.
+  */
+	T *getZ(void)
+	{
+		return withZ ? z.data() : NULL;
+	}
+
+public:
+/**
+  *\fn BasicPointSetView<T> getView(void) const
+  *\return a view of all the points
+  *
+  *\brief Get a view of the points to pass to the hull algorithms.
+  *
+  *The view is invalidated when a point is inserted.
+  */
+	BasicPointSetView<T> getView(void) const
+	{
+		return BasicPointSetView<T>(x.data(), y.data(), withZ ? z.data() : NULL, x.size());
+	}
+
+public:
+/**
+  *\brief Allows a set to be passed where a view of the same type of points is required.
+  */
+	operator BasicPointSetView<T>() const
+	{
+		return getView();
+	}
+
+public:
+/**
+  *\fn vector<BasicPoint<T> > toVector(void) const
+  *\return a vector of points
+  *
+  *\brief Convert the set back to a vector of points.
+  *
+  *The order of the points is maintained.
+  */
+	vector<BasicPoint<T> > toVector(void) const
+	{
+		vector<BasicPoint<T> > result;
+		result.reserve(x.size());
+		for(int iter = 0; iter < getSize(); iter++)
+			result.push_back(getPoint(iter));
+		return result;
+	}
+};
+
+/**
+  *\var typedef BasicPointSet<double> PointSet
+  *\brief The set of points with double co-ordinates.
+  */
+typedef BasicPointSet<double> PointSet;
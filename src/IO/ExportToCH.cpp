@@ -16,15 +16,17 @@
 class ExportToCH
 {
 /**
-  *\fn static void write(vector<Point> points, vector<int> ch, string filepath)
-  *\param vector<Point> points
-  *\param vector<int> ch
+  *\fn static void write(const vector<Point> &points, const vector<int> &ch, string filepath, bool hullOnly)
+  *\param const vector<Point> &points
+  *\param const vector<int> &ch
   *\param string filepath
+  *\param bool hullOnly
   *
   *\brief a function to convert set of points and its convex hull to a .ch file.
   *
   *Pass the vector of points, a vector containing index of points and a filepath to store the data.
   *It would create a new file, overwrite an existing file if it is the case and fill the data.
+  *If hullOnly is true only the points on the convex hull are written, in the order of ch, and the indices are 0 to h - 1.
   *Though the function is currently static, changes are planned.
   *.ch is a file format to represent a set of points and its convex hull.
   *It has been developed at BITS Pilani University.
@@ -32,14 +34,345 @@ class ExportToCH
   *
   */
 public:
-	static void write(vector<Point> points, vector<int> ch, string filepath)
+	static void write(const vector<Point> &points, const vector<int> &ch, string filepath, bool hullOnly = false)
 	{
-		ofstream file;
-		file.open(filepath);			//open the file
-		file << "CH\n" << points.size() << " " << ch.size() << "\n";
-		for(Point p : points)
-			file << p.x << " " << p.y << " " << p.z << "\n";		//enter all the points
+		writeHull(filepath, points.size(), [&points](int i) { return points[i]; }, ch, hullOnly);
+	}
+
+/**
+  *\fn static void write(PointSetView points, const vector<int> &ch, string filepath, bool hullOnly)
+  *\param PointSetView points
+  *\param const vector<int> &ch
+  *\param string filepath
+  *\param bool hullOnly
+  *
+  *\brief a function to convert a PointSetView and its convex hull to a .ch file.
+  *
+  *It writes the same format as the function taking a vector of points.
+  *The z co-ordinates are written as zero if the view has none.
+  *
+  */
+public:
+	static void write(PointSetView points, const vector<int> &ch, string filepath, bool hullOnly = false)
+	{
+		writeHull(filepath, points.size, [&points](int i) { return points.getPoint(i); }, ch, hullOnly);
+	}
+
+/**
+  *\fn static void write(const vector<Point> &points, const vector<Facet> &facets, string filepath, bool hullOnly)
+  *\param const vector<Point> &points
+  *\param const vector<Facet> &facets
+  *\param string filepath
+  *\param bool hullOnly
+  *
+  *\brief a function to convert set of points and its convex hull in 3D to a .ch file.
+  *
+  *The points are written like in the 2D format, but the header is CH3.
+  *Then every facet is written on its own line as the number of corners followed by their indices, i.e. "3 a b c".
+  *The corners are in anti-clockwise order as seen from outside the hull.
+  *If hullOnly is true only the corners of the facets are written, in the order of their indices, and the facets are numbered again.
+  *
+  */
+public:
+	static void write(const vector<Point> &points, const vector<Facet> &facets, string filepath, bool hullOnly = false)
+	{
+		writeFacets(filepath, points.size(), [&points](int i) { return points[i]; }, facets, hullOnly);
+	}
+
+/**
+  *\fn static void write(PointSetView points, const vector<Facet> &facets, string filepath, bool hullOnly)
+  *\param PointSetView points
+  *\param const vector<Facet> &facets
+  *\param string filepath
+  *\param bool hullOnly
+  *
+  *\brief a function to convert a PointSetView and its convex hull in 3D to a .ch file.
+  *
+  *It writes the same format as the function taking a vector of points.
+  *
+  */
+public:
+	static void write(PointSetView points, const vector<Facet> &facets, string filepath, bool hullOnly = false)
+	{
+		writeFacets(filepath, points.size, [&points](int i) { return points.getPoint(i); }, facets, hullOnly);
+	}
+
+/**
+  *\fn template<class Get> static void writeHull(string filepath, int n, Get point, const vector<int> &ch, bool hullOnly)
+  *
+  *\brief Write a 2D .ch file, point(i) returns the point at index i.
+  */
+private:
+	template<class Get>
+	static void writeHull(string filepath, int n, Get point, const vector<int> &ch, bool hullOnly)
+	{
+		Writer file(filepath);			//open the file
+		file.put("CH\n");
+		file.put(hullOnly ? (long long)ch.size() : n);
+		file.put(' ');
+		file.put((long long)ch.size());
+		file.put('\n');
+		if(hullOnly)
+		{
+			for(int i : ch)
+				file.put(point(i));				//enter the points on convex hull
+			for(int iter = 0; iter < (int)ch.size(); iter++)
+			{
+				file.put(iter);
+				file.put(' ');
+			}
+			return;
+		}
+		for(int iter = 0; iter < n; iter++)
+			file.put(point(iter));				//enter all the points
 		for(int i : ch)
-			file << i << " ";							//enter indices of points on convex hull
+		{
+			file.put(i);						//enter indices of points on convex hull
+			file.put(' ');
+		}
+	}
+
+/**
+  *\fn template<class Get> static void writeFacets(string filepath, int n, Get point, const vector<Facet> &facets, bool hullOnly)
+  *
+  *\brief Write a 3D .ch file, point(i) returns the point at index i.
+  */
+private:
+	template<class Get>
+	static void writeFacets(string filepath, int n, Get point, const vector<Facet> &facets, bool hullOnly)
+	{
+		vector<int> index;						//the new index of every point if hullOnly is true, -1 if it is not written
+		vector<int> corners;
+		if(hullOnly)
+		{
+			index.assign(n, -1);
+			for(const Facet &f : facets)
+				index[f.a] = index[f.b] = index[f.c] = 0;
+			for(int iter = 0; iter < n; iter++)
+				if(index[iter] == 0)
+				{
+					index[iter] = corners.size();
+					corners.push_back(iter);
+				}
+		}
+
+		Writer file(filepath);			//open the file
+		file.put("CH3\n");
+		file.put(hullOnly ? (long long)corners.size() : n);
+		file.put(' ');
+		file.put((long long)facets.size());
+		file.put('\n');
+		if(hullOnly)
+			for(int i : corners)
+				file.put(point(i));				//enter the corners of the hull
+		else
+			for(int iter = 0; iter < n; iter++)
+				file.put(point(iter));			//enter all the points
+		for(const Facet &f : facets)			//enter the corners of every facet
+		{
+			file.put("3 ");
+			file.put(hullOnly ? index[f.a] : f.a);
+			file.put(' ');
+			file.put(hullOnly ? index[f.b] : f.b);
+			file.put(' ');
+			file.put(hullOnly ? index[f.c] : f.c);
+			file.put('\n');
+		}
+	}
+
+/**
+  *\class Writer
+  *\brief A file written through a large buffer, so that the numbers are formatted in memory and written with a few large calls.
+  *
+  *The numbers are formatted with to_chars when the compiler has it, which writes a double with the shortest text that reads back to the same value.
+  *Otherwise they are formatted with snprintf, with 6 significant digits like an ofstream.
+  *The buffer is written out when it is full and when the Writer is destroyed.
+  */
+private:
+	class Writer
+	{
+		FILE *file;
+		vector<char> buffer;
+		size_t used;
+
+	public:
+		Writer(string filepath)
+		{
+			file = fopen(filepath.c_str(), "w");
+			buffer.resize(1 << 20);
+			used = 0;
+		}
+
+		~Writer()
+		{
+			flush();
+			if(file != NULL)
+				fclose(file);
+		}
+
+		Writer(const Writer &) = delete;
+		Writer &operator=(const Writer &) = delete;
+
+		void put(char c)
+		{
+			room(1);
+			buffer[used++] = c;
+		}
+
+		void put(const char *text)
+		{
+			size_t length = strlen(text);
+			room(length);
+			memcpy(buffer.data() + used, text, length);
+			used += length;
+		}
+
+		void put(long long value)
+		{
+			room(24);
+#ifdef CGEO_CHARCONV
+			used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+#else
+			used += snprintf(buffer.data() + used, 24, "%lld", value);
+#endif
+		}
+
+		void put(int value)
+		{
+			put((long long)value);
+		}
+
+		void put(double value)
+		{
+			room(32);
+#ifdef CGEO_CHARCONV
+			used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+#else
+			used += snprintf(buffer.data() + used, 32, "%g", value);
+#endif
+		}
+
+		void put(const Point &p)
+		{
+			put(p.x);
+			put(' ');
+			put(p.y);
+			put(' ');
+			put(p.z);
+			put('\n');
+		}
+
+	private:
+		void room(size_t length)
+		{
+			if(used + length > buffer.size())
+				flush();
+		}
+
+		void flush(void)
+		{
+			if(file != NULL && used > 0)
+				fwrite(buffer.data(), 1, used, file);
+			used = 0;
+		}
+	};
+
+/**
+  *\fn static void writeBinary(PointSetView points, const vector<int> &ch, string filepath)
+  *\param PointSetView points
+  *\param const vector<int> &ch
+  *\param string filepath
+  *
+  *\brief a function to save a set of points and its convex hull as a binary .chb file.
+  *
+  *A .chb file has a header of 32 bytes followed by the arrays of the x, y and (if present) z co-ordinates
+  *and the array of the indices of the points on the convex hull.
+  *The header is the text "CHB" with a zero byte, the version, the flags, 4 zero bytes, the number of points and the number of indices.
+  *The version, the flags and the indices are 32 bit integers, the numbers are 64 bit integers and the co-ordinates are doubles,
+  *all of them little endian. The flag 1 is set if the z co-ordinates are stored.
+  *Every array starts at a multiple of 8 bytes, so ImportCHB can use them in place.
+  *
+  */
+public:
+	static void writeBinary(PointSetView points, const vector<int> &ch, string filepath)
+	{
+		ofstream file;
+		file.open(filepath, ios::binary);			//open the file
+		file.write("CHB", 4);
+		uint32_t header[3] = {CHB_VERSION, points.z ? 1u : 0u, 0u};
+		putLittleEndian(file, header, 3);
+		uint64_t sizes[2] = {(uint64_t)points.size, (uint64_t)ch.size()};
+		putLittleEndian(file, sizes, 2);
+		putLittleEndian(file, points.x, points.size);
+		putLittleEndian(file, points.y, points.size);
+		if(points.z)
+			putLittleEndian(file, points.z, points.size);
+		putLittleEndian(file, ch.data(), ch.size());
+	}
+
+/**
+  *\fn static void writeBinary(const vector<Point> &points, const vector<int> &ch, string filepath)
+  *\param const vector<Point> &points
+  *\param const vector<int> &ch
+  *\param string filepath
+  *
+  *\brief a function to save a vector of points and its convex hull as a binary .chb file, with the z co-ordinates.
+  *
+  */
+public:
+	static void writeBinary(const vector<Point> &points, const vector<int> &ch, string filepath)
+	{
+		PointSet set(points, true);
+		writeBinary(set.getView(), ch, filepath);
+	}
+
+/**
+  *\var static const uint32_t CHB_VERSION
+  *\brief The version of the .chb format written by writeBinary.
+  */
+public:
+	static constexpr uint32_t CHB_VERSION = 1;
+
+/**
+  *\fn static bool isLittleEndian(void)
+  *\return true if the machine stores numbers with the least significant byte first
+  */
+public:
+	static bool isLittleEndian(void)
+	{
+		uint16_t one = 1;
+		unsigned char first;
+		memcpy(&first, &one, 1);
+		return first == 1;
+	}
+
+/**
+  *\fn template<class T> static void putLittleEndian(ofstream &file, const T *values, size_t count)
+  *
+  *\brief Write an array of numbers in little endian order.
+  *
+  *The array is written at once on a little endian machine, otherwise the bytes of every number are reversed in blocks.
+  */
+private:
+	template<class T>
+	static void putLittleEndian(ofstream &file, const T *values, size_t count)
+	{
+		if(isLittleEndian())
+		{
+			file.write((const char *)values, count * sizeof(T));
+			return;
+		}
+		const size_t BLOCK = 1 << 12;
+		vector<char> buffer(BLOCK * sizeof(T));
+		for(size_t begin = 0; begin < count; begin += BLOCK)
+		{
+			size_t end = min(count, begin + BLOCK);
+			for(size_t iter = begin; iter < end; iter++)
+			{
+				const char *bytes = (const char *)(values + iter);
+				reverse_copy(bytes, bytes + sizeof(T), buffer.begin() + (iter - begin) * sizeof(T));
+			}
+			file.write(buffer.data(), (end - begin) * sizeof(T));
+		}
 	}
-};
\ No newline at end of file
+};
@@ -8,8 +8,10 @@
   *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
   *
   *The class has static methods to fetch function from input.
-  *Currently it only suppports input from standard input.
-  *If required in the project, functions would be developed to take input from files as well.
+  *getInput asks for the points one by one on the standard input.
+  *getChunk reads the points in chunks of a fixed size from the standard input or a file,
+  *so that a large input never has to be in memory at once.
+  *load and loadFile read a whole text file of points as fast as possible, in large blocks and with several threads.
   *Equivalent classes to fetch lines or polygons can also be developed
   */
 class GetPoints
@@ -30,17 +32,257 @@ public:
 		vector<Point> input;
 		int n;
 		double x, y, z;
-		Point *p;
 		cout<<"Please enter the number of points : ";
 		scanf("%d", &n);
 		for(int iter = 0; iter < n; iter++)
 		{
 			cout<<"Please enter x ,y and z co-ordinates sepreated by a space for point " << iter << " : ";
 			scanf("%lf %lf %lf", &x, &y, &z);
-			p = new Point(x, y, z);
-			input.push_back(*p);
+			input.push_back(Point(x, y, z));
 		}
 		return input;
 	}
-};
 
+/**
+  *\fn static int getChunk(FILE *source, PointSet &chunk, int size)
+  *\param FILE *source stdin or a file opened for reading
+  *\param PointSet &chunk
+  *\param int size the greatest number of points to read
+  *\return the number of points read, zero at the end of the input
+  *
+  *\brief Reads the next chunk of points from source into chunk.
+  *
+  *The points are read as x, y and z co-ordinates separated by white space, without any prompt or count.
+  *The old points of chunk are removed, but its memory is kept for the next chunk.
+  *Reading stops at the end of the input or at the first co-ordinate which is not a number.
+  */
+public:
+	static int getChunk(FILE *source, PointSet &chunk, int size)
+	{
+		double x, y, z;
+		chunk.clear();
+		while(chunk.getSize() < size && fscanf(source, "%lf %lf %lf", &x, &y, &z) == 3)
+			chunk.insertAtLast(x, y, z);
+		return chunk.getSize();
+	}
+
+/**
+  *\fn static int loadFile(string filepath, PointSet &points, int threads)
+  *\param string filepath
+  *\param PointSet &points the points are added at its end
+  *\param int threads zero or less means the number of hardware threads
+  *\return the number of points read, -1 if the file can not be opened
+  *
+  *\brief Reads all the points of a text file.
+  *
+  *Every line holds the x, y and optionally z co-ordinates of a point, separated by spaces, tabs, commas or semicolons,
+  *so both plain text and CSV files can be read. A line without z gets z as zero and extra columns are ignored.
+  *Lines which do not start with two numbers, like a CSV header or an empty line, are skipped.
+  *The file is mapped into memory if possible and read in blocks otherwise, see load.
+  */
+public:
+	static int loadFile(string filepath, PointSet &points, int threads = 0)
+	{
+#ifdef CGEO_MMAP
+		int descriptor = open(filepath.c_str(), O_RDONLY);
+		if(descriptor < 0)
+			return -1;
+		struct stat info;
+		if(fstat(descriptor, &info) == 0 && info.st_size > 0)
+		{
+			void *mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			close(descriptor);
+			if(mapped == MAP_FAILED)
+				return -1;
+			int before = points.getSize();
+			parseBlock((const char *)mapped, (const char *)mapped + info.st_size, points, threads);
+			munmap(mapped, info.st_size);
+			return points.getSize() - before;
+		}
+		close(descriptor);
+#endif
+		FILE *source = fopen(filepath.c_str(), "rb");
+		if(source == NULL)
+			return -1;
+		int count = load(source, points, threads);
+		fclose(source);
+		return count;
+	}
+
+/**
+  *\fn static int load(FILE *source, PointSet &points, int threads)
+  *\param FILE *source stdin or a file opened for reading
+  *\param PointSet &points the points are added at its end
+  *\param int threads zero or less means the number of hardware threads
+  *\return the number of points read
+  *
+  *\brief Reads all the points from source, in the format of loadFile.
+  *
+  *The input is read in blocks of 64 MB. The complete lines of every block are split between the threads,
+  *which parse their parts straight into the arrays of points.
+  */
+public:
+	static int load(FILE *source, PointSet &points, int threads = 0)
+	{
+		const size_t BLOCK = 1 << 26;
+		vector<char> buffer(BLOCK);
+		size_t kept = 0;
+		int before = points.getSize();
+		while(true)
+		{
+			size_t read = fread(buffer.data() + kept, 1, buffer.size() - kept, source);
+			size_t filled = kept + read;
+			if(read == 0)
+			{
+				parseBlock(buffer.data(), buffer.data() + filled, points, threads);	//the last line has no new line
+				break;
+			}
+			const char *last = buffer.data() + filled;
+			while(last > buffer.data() && last[-1] != '\n')
+				last--;
+			if(last == buffer.data())				//no complete line yet
+			{
+				if(filled == buffer.size())			//a line longer than the buffer
+					buffer.resize(2 * buffer.size());
+				kept = filled;
+				continue;
+			}
+			parseBlock(buffer.data(), last, points, threads);
+			kept = buffer.data() + filled - last;
+			memmove(buffer.data(), last, kept);
+		}
+		return points.getSize() - before;
+	}
+
+/**
+  *\fn static void parseBlock(const char *begin, const char *end, PointSet &points, int threads)
+  *
+  *\brief Parse the lines from begin to end into the end of points.
+  *
+  *The block is split into one part per thread at the starts of lines.
+  *The new lines of every part are counted first, which bounds its number of points, and the arrays are grown once for all of them.
+  *Every thread then parses its part in place from its own offset, and the gaps left by skipped lines are closed at the end.
+  */
+private:
+	static void parseBlock(const char *begin, const char *end, PointSet &points, int threads)
+	{
+		const size_t MIN_PART = 1 << 20;
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		threads = max(1, min(threads, (int)((end - begin) / MIN_PART)));
+
+		vector<const char *> bounds(threads + 1, end);
+		bounds[0] = begin;
+		for(int iter = 1; iter < threads; iter++)
+		{
+			const char *at = max(bounds[iter - 1], begin + (end - begin) * iter / threads);
+			const char *line = (const char *)memchr(at, '\n', end - at);
+			bounds[iter] = line ? line + 1 : end;
+		}
+		vector<int> offsets(threads + 1, points.getSize()), counts(threads);
+		for(int iter = 0; iter < threads; iter++)
+			offsets[iter + 1] = offsets[iter] + count(bounds[iter], bounds[iter + 1], '\n') + 1;
+		points.resize(offsets[threads]);
+
+		double *x = points.getX(), *y = points.getY(), *z = points.getZ();
+		vector<thread> workers;
+		for(int iter = 1; iter < threads; iter++)
+			workers.push_back(thread([&, iter]() {
+				counts[iter] = parsePart(bounds[iter], bounds[iter + 1], x + offsets[iter], y + offsets[iter], z ? z + offsets[iter] : NULL);
+			}));
+		counts[0] = parsePart(bounds[0], bounds[1], x + offsets[0], y + offsets[0], z ? z + offsets[0] : NULL);
+		for(thread &t : workers)
+			t.join();
+
+		int size = offsets[0] + counts[0];
+		for(int iter = 1; iter < threads; iter++)		//close the gaps between the parts
+		{
+			memmove(x + size, x + offsets[iter], counts[iter] * sizeof(double));
+			memmove(y + size, y + offsets[iter], counts[iter] * sizeof(double));
+			if(z)
+				memmove(z + size, z + offsets[iter], counts[iter] * sizeof(double));
+			size += counts[iter];
+		}
+		points.resize(size);
+	}
+
+/**
+  *\fn static int parsePart(const char *begin, const char *end, double *x, double *y, double *z)
+  *\return the number of points written to the arrays
+  *
+  *\brief Parse the lines from begin to end, z is NULL if the z co-ordinates are not stored.
+  */
+private:
+	static int parsePart(const char *begin, const char *end, double *x, double *y, double *z)
+	{
+		int count = 0;
+		while(begin < end)
+		{
+			const char *line = (const char *)memchr(begin, '\n', end - begin);
+			if(line == NULL)
+				line = end;
+			double values[3] = {0.0, 0.0, 0.0};
+			int found = 0;
+			const char *next = begin;
+			while(found < 3)
+			{
+				while(next < line && (*next == ' ' || *next == '\t' || *next == ',' || *next == ';' || *next == '\r'))
+					next++;
+				if(next == line || (next = parseNumber(next, line, values[found])) == NULL)
+					break;
+				found++;
+			}
+			if(found >= 2)
+			{
+				x[count] = values[0];
+				y[count] = values[1];
+				if(z)
+					z[count] = values[2];
+				count++;
+			}
+			begin = line + 1;
+		}
+		return count;
+	}
+
+/**
+  *\fn static const char *parseNumber(const char *begin, const char *end, double &value)
+  *\return the end of the number, NULL if there is no number at begin
+  *
+  *\brief Uses from_chars when the compiler has it and strtod on a copy of the number otherwise.
+  *
+  *Both read the same numbers, which is the grammar of from_chars after an optional plus sign.
+  *strtod would also skip white space and read hexadecimal numbers, so the fallback rejects a number which does not start
+  *with a digit, a point or the first letter of inf or nan, and reads only the 0 of a 0x prefix like from_chars does.
+  */
+private:
+	static const char *parseNumber(const char *begin, const char *end, double &value)
+	{
+		if(*begin == '+' && begin + 1 < end)
+			begin++;
+#ifdef CGEO_CHARCONV
+		from_chars_result result = from_chars(begin, end, value);
+		return result.ec == errc() ? result.ptr : NULL;
+#else
+		const char *digits = begin + (*begin == '-');
+		if(digits == end || (!isdigit((unsigned char)*digits) && *digits != '.' && strchr("iInN", *digits) == NULL))
+			return NULL;
+		if(*digits == '0' && digits + 1 < end && (digits[1] == 'x' || digits[1] == 'X'))
+		{
+			value = digits == begin ? 0.0 : -0.0;
+			return digits + 1;
+		}
+		char number[64];
+		int length = 0;
+		while(begin + length < end && length < 63 && strchr(" \t,;\r", begin[length]) == NULL)
+		{
+			number[length] = begin[length];
+			length++;
+		}
+		number[length] = 0;
+		char *stop;
+		value = strtod(number, &stop);
+		return stop == number ? NULL : begin + (stop - number);
+#endif
+	}
+};
@@ -0,0 +1,238 @@
+/**\file: ImportCHB.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A class to read a set of points and its convex hull from a binary .chb file.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The .chb format is written by ExportToCH::writeBinary, see it for the layout.
+  *On a little endian machine with mmap (Linux, macOS) the file is mapped into memory and nothing is copied or parsed,
+  *the co-ordinate arrays of the file are used in place by the PointSetView returned by getPoints.
+  *Otherwise the file is read into memory once.
+  *The object keeps the file mapped, so it must live longer than the views taken from it.
+  */
+class ImportCHB
+{
+private:
+/**
+  *\var PointSetView points
+  *\brief The points, in the mapped file or in the vectors below.
+  *
+  *\var const int32_t *hull
+  *\brief The indices of the points on the hull, in the mapped file or in the vectors below.
+  *
+  *\var vector<double> x, y, z and vector<int32_t> ch
+  *\brief The copy of the arrays when the file is not mapped.
+  *
+  *\var void *mapped
+  *\brief The start of the mapped file, NULL if the file is not mapped.
+  *
+  *\var size_t length
+  *\brief The size of the mapped file in bytes.
+  */
+	PointSetView points;
+	const int32_t *hull;
+	int hullSize;
+	bool loaded;
+	vector<double> x, y, z;
+	vector<int32_t> ch;
+	void *mapped;
+	size_t length;
+
+public:
+/**
+  *\param string filepath
+  *
+  *\brief A constructor which opens the .chb file at the given filepath.
+  *
+  *Check isOpen() to know if the file could be read.
+  *It fails if the file is missing, if it is not a .chb file of a known version, if its size does not match its header
+  *or if an index of the hull is not the index of a point.
+  */
+	ImportCHB(string filepath)
+	{
+		hull = NULL;
+		hullSize = 0;
+		loaded = false;
+		mapped = NULL;
+		length = 0;
+		if(ExportToCH::isLittleEndian() && mapFile(filepath))
+			return;
+		readFile(filepath);
+	}
+
+/**
+  *\brief A destructor which unmaps the file.
+  */
+public:
+	~ImportCHB()
+	{
+#ifdef CGEO_MMAP
+		if(mapped != NULL)
+			munmap(mapped, length);
+#endif
+	}
+
+/**
+  *\brief The object owns the mapping, so it can not be copied.
+  */
+public:
+	ImportCHB(const ImportCHB &) = delete;
+	ImportCHB &operator=(const ImportCHB &) = delete;
+
+public:
+/**
+  *\fn bool isOpen(void) const
+  *\return true if the file was read
+  */
+	bool isOpen(void) const
+	{
+		return loaded;
+	}
+
+public:
+/**
+  *\fn PointSetView getPoints(void) const
+  *\return a view of the points of the file, which can be passed to the hull algorithms
+  */
+	PointSetView getPoints(void) const
+	{
+		return points;
+	}
+
+public:
+/**
+  *\fn vector<int> getHull(void) const
+  *\return the indices of the points on the convex hull
+  */
+	vector<int> getHull(void) const
+	{
+		return vector<int>(hull, hull + hullSize);
+	}
+
+/**
+  *\fn bool parse(const unsigned char *data, size_t size, uint64_t &n, uint64_t &h, bool &withZ)
+  *\return true if data starts with a valid header, its size matches it and every index of the hull is a point
+  *
+  *\brief The numbers of the header are read byte by byte, so it works on any machine.
+  *
+  *The indices are checked against n here, so getHull never gives an index outside the points to ExportToCH or to a Polygon.
+  */
+private:
+	static bool parse(const unsigned char *data, size_t size, uint64_t &n, uint64_t &h, bool &withZ)
+	{
+		if(size < 32 || memcmp(data, "CHB", 4) != 0 || readNumber(data + 4, 4) != ExportToCH::CHB_VERSION)
+			return false;
+		withZ = readNumber(data + 8, 4) & 1;
+		n = readNumber(data + 16, 8);
+		h = readNumber(data + 24, 8);
+		if(n > (uint64_t)INT_MAX || h > (uint64_t)INT_MAX || size != 32 + n * 8 * (withZ ? 3 : 2) + h * 4)
+			return false;
+		const unsigned char *indices = data + 32 + n * 8 * (withZ ? 3 : 2);
+		for(uint64_t iter = 0; iter < h; iter++)
+		{
+			int32_t index = (int32_t)(uint32_t)readNumber(indices + iter * 4, 4);
+			if(index < 0 || (uint64_t)index >= n)
+				return false;
+		}
+		return true;
+	}
+
+	static uint64_t readNumber(const unsigned char *data, int bytes)
+	{
+		uint64_t result = 0;
+		for(int iter = bytes - 1; iter >= 0; iter--)
+			result = (result << 8) | data[iter];
+		return result;
+	}
+
+/**
+  *\fn bool mapFile(string filepath)
+  *\return true if the file was mapped and is valid
+  *
+  *\brief Map the file read only and point the view and the hull into it.
+  */
+private:
+	bool mapFile(string filepath)
+	{
+#ifdef CGEO_MMAP
+		int descriptor = ::open(filepath.c_str(), O_RDONLY);
+		if(descriptor < 0)
+			return false;
+		struct stat info;
+		if(fstat(descriptor, &info) != 0 || info.st_size < 32)
+		{
+			close(descriptor);
+			return false;
+		}
+		length = info.st_size;
+		mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		close(descriptor);						//the mapping stays after the file is closed
+		if(mapped == MAP_FAILED)
+		{
+			mapped = NULL;
+			return false;
+		}
+		const unsigned char *data = (const unsigned char *)mapped;
+		uint64_t n, h;
+		bool withZ;
+		if(!parse(data, length, n, h, withZ))
+		{
+			munmap(mapped, length);
+			mapped = NULL;
+			return false;
+		}
+		const double *arrays = (const double *)(data + 32);
+		points = PointSetView(arrays, arrays + n, withZ ? arrays + 2 * n : NULL, n);
+		hull = (const int32_t *)(arrays + (withZ ? 3 : 2) * n);
+		hullSize = h;
+		loaded = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+/**
+  *\fn void readFile(string filepath)
+  *
+  *\brief Read the whole file into the vectors, reversing the bytes of the numbers on a big endian machine.
+  */
+private:
+	void readFile(string filepath)
+	{
+		ifstream file(filepath, ios::binary);
+		if(!file)
+			return;
+		vector<unsigned char> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+		uint64_t n, h;
+		bool withZ;
+		if(!parse(data.data(), data.size(), n, h, withZ))
+			return;
+		const unsigned char *next = data.data() + 32;
+		next = getArray(next, x, n);
+		next = getArray(next, y, n);
+		if(withZ)
+			next = getArray(next, z, n);
+		getArray(next, ch, h);
+		points = PointSetView(x.data(), y.data(), withZ ? z.data() : NULL, n);
+		hull = ch.data();
+		hullSize = h;
+		loaded = true;
+	}
+
+	template<class T>
+	static const unsigned char *getArray(const unsigned char *data, vector<T> &values, size_t count)
+	{
+		values.resize(count);
+		unsigned char *bytes = (unsigned char *)values.data();
+		if(ExportToCH::isLittleEndian())
+			memcpy(bytes, data, count * sizeof(T));
+		else
+			for(size_t iter = 0; iter < count; iter++)
+				reverse_copy(data + iter * sizeof(T), data + (iter + 1) * sizeof(T), bytes + iter * sizeof(T));
+		return data + count * sizeof(T);
+	}
+};
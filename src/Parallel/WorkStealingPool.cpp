@@ -0,0 +1,271 @@
+/**\file: WorkStealingPool.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A pool of threads which run recursive tasks, idle threads steal work from the busy ones.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *Every thread of the pool has its own queue of tasks.
+  *A task started from a thread of the pool goes to the back of that thread's queue, and the thread takes its next task from the back as well.
+  *So a thread works depth first on its own part of a recursion, which keeps its data in the cache.
+  *A thread with an empty queue takes a task from the front of another queue, which is the largest piece of work waiting there.
+  *Tasks are started in a Group, and waiting for a Group runs other tasks till all the tasks of the Group are done.
+  *So a task may start sub-tasks and wait for them without blocking a thread of the pool.
+  */
+class WorkStealingPool
+{
+/**
+  *\class Group
+  *\brief A set of tasks which can be waited for, see run() and wait().
+  *
+  *A Group must not be destroyed before wait() has returned for it.
+  */
+public:
+	class Group
+	{
+		friend class WorkStealingPool;
+		atomic<int> pending;
+	public:
+		Group()
+		{
+			pending = 0;
+		}
+	};
+
+/**
+  *\fn WorkStealingPool(int threads)
+  *\param int threads the number of threads, zero or less means the number of hardware threads
+  *
+  *\brief A constructor which starts the threads.
+  *
+  *The thread which waits for a Group helps the pool as well, so one thread less is started.
+  */
+public:
+	WorkStealingPool(int threads = 0)
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 0)
+			threads = 1;
+		size = threads;
+		stop = false;
+		queued = 0;
+		for(int iter = 0; iter < size; iter++)			//the last queue is for the threads outside the pool
+			queues.push_back(unique_ptr<Queue>(new Queue()));
+		for(int iter = 0; iter < size - 1; iter++)
+			workers.push_back(thread([this, iter]() { work(iter); }));
+	}
+
+/**
+  *\brief A destructor which stops the threads, all the Groups must have been waited for.
+  */
+public:
+	~WorkStealingPool()
+	{
+		{
+			lock_guard<mutex> guard(sleep);
+			stop = true;
+		}
+		wake.notify_all();
+		for(thread &t : workers)
+			t.join();
+	}
+
+/**
+  *\fn int getSize(void)
+  *\return the number of threads that run the tasks, including the one that waits
+  */
+public:
+	int getSize(void)
+	{
+		return size;
+	}
+
+/**
+  *\fn void run(Group &group, function<void()> task)
+  *\param Group &group
+  *\param function<void()> task
+  *
+  *\brief Start a task in the group.
+  *
+  *The task is put at the back of the queue of the calling thread and any idle thread is woken up.
+  */
+public:
+	void run(Group &group, function<void()> task)
+	{
+		group.pending++;
+		Queue &queue = *queues[self()];
+		{
+			lock_guard<mutex> guard(queue.lock);
+			queue.tasks.push_back(Task(task, &group));
+		}
+		queued++;
+		{
+			lock_guard<mutex> guard(sleep);
+		}
+		wake.notify_one();
+	}
+
+/**
+  *\fn void wait(Group &group)
+  *\param Group &group
+  *
+  *\brief Wait till all the tasks of the group, and the tasks they started in it, are done.
+  *
+  *The calling thread runs waiting tasks in the meantime, first from its own queue and then from the others.
+  */
+public:
+	void wait(Group &group)
+	{
+		int index = self();
+		while(group.pending > 0)
+		{
+			Task task;
+			if(take(index, task))
+				execute(task);
+			else
+				this_thread::yield();
+		}
+	}
+
+/**
+  *\var struct Task
+  *\brief A task and the group it was started in.
+  *
+  *\var struct Queue
+  *\brief The queue of a thread, a deque guarded by a mutex.
+  */
+private:
+	struct Task
+	{
+		function<void()> call;
+		Group *group;
+		Task()
+		{
+			group = NULL;
+		}
+		Task(function<void()> call, Group *group) : call(call), group(group)
+		{
+		}
+	};
+
+	struct Queue
+	{
+		mutex lock;
+		deque<Task> tasks;
+	};
+
+	int size;
+	vector<unique_ptr<Queue>> queues;
+	vector<thread> workers;
+	atomic<int> queued;
+	bool stop;
+	mutex sleep;
+	condition_variable wake;
+
+/**
+  *\fn int self(void)
+  *\return the index of the queue of the calling thread, size - 1 if it is not a thread of this pool
+  */
+private:
+	int self(void)
+	{
+		const Owner &owner = current();
+		return (owner.pool == this)? owner.index : size - 1;
+	}
+
+/**
+  *\var struct Owner
+  *\brief The pool and the queue of the current thread, set once when a worker starts.
+  */
+private:
+	struct Owner
+	{
+		const WorkStealingPool *pool;
+		int index;
+	};
+
+	static Owner &current(void)
+	{
+		static thread_local Owner owner = {NULL, 0};
+		return owner;
+	}
+
+/**
+  *\fn bool take(int index, Task &task)
+  *\param int index the queue of the calling thread
+  *\param Task &task to store the task
+  *\return true if a task was found
+  *
+  *\brief Take the newest task of the own queue, or else steal the oldest task of another queue.
+  */
+private:
+	bool take(int index, Task &task)
+	{
+		if(queued == 0)
+			return false;
+		{
+			Queue &queue = *queues[index];
+			lock_guard<mutex> guard(queue.lock);
+			if(!queue.tasks.empty())
+			{
+				task = move(queue.tasks.back());
+				queue.tasks.pop_back();
+				queued--;
+				return true;
+			}
+		}
+		for(int iter = 1; iter < size; iter++)
+		{
+			Queue &queue = *queues[(index + iter) % size];
+			lock_guard<mutex> guard(queue.lock);
+			if(!queue.tasks.empty())
+			{
+				task = move(queue.tasks.front());
+				queue.tasks.pop_front();
+				queued--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+/**
+  *\fn void execute(Task &task)
+  *\brief Run a task and mark it done in its group.
+  */
+private:
+	void execute(Task &task)
+	{
+		task.call();
+		task.group->pending--;
+	}
+
+/**
+  *\fn void work(int index)
+  *\param int index the queue of the thread
+  *
+  *\brief The loop of a thread of the pool, it sleeps while there is nothing to take.
+  */
+private:
+	void work(int index)
+	{
+		current().pool = this;
+		current().index = index;
+		while(true)
+		{
+			Task task;
+			if(take(index, task))
+			{
+				execute(task);
+				continue;
+			}
+			unique_lock<mutex> guard(sleep);
+			wake.wait(guard, [this]() { return stop || queued > 0; });
+			if(stop)
+				return;
+		}
+	}
+};
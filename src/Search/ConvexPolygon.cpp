@@ -0,0 +1,704 @@
+/**\file: ConvexPolygon.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A convex polygon prepared for fast queries, e.g. a hull against which many points are classified.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The corners of the polygon are copied once into arrays, anticlockwise, without repeated corners or corners in the middle of an edge,
+  *so the polygon may come from any hull algorithm in any orientation.
+  *A point is located by a binary search on the fan of triangles from the first corner p0:
+  *the point is in the wedge of the triangle p0, p[i], p[i + 1] with the largest i such that it is not on the right of p0 to p[i],
+  *and then a single orientation test against the edge p[i] to p[i + 1] tells if it is inside, on the boundary or outside.
+  *So a query takes O(logh) time for h corners.
+  *The binary search has the same number of steps for all the points, which lets the AVX2 version of the batch function
+  *search four points at once, reading the corners with gathers. The batch function can also run on a WorkStealingPool.
+  *Both versions evaluate the same expressions, so they give exactly the same results.
+  *The orientation tests are plain floating point, a point very close to an edge may be classified either way.
+  *
+  *The first corner is the leftmost one, so the edges are sorted by their angle and the polygon is split at the rightmost corner
+  *into a lower and an upper chain on which x only increases and only decreases.
+  *The corner farthest in a direction is then found by a binary search on the angles of the edges,
+  *and the tangents from a point by binary searches for the edges it sees on each chain, both in O(logh) time.
+  */
+class ConvexPolygon
+{
+public:
+/**
+  *\var enum Location
+  *\brief Where a point is with respect to the polygon.
+  */
+	enum Location { OUTSIDE, BOUNDARY, INSIDE };
+
+public:
+/**
+  *\brief A constructor for an empty polygon, every point is outside it.
+  */
+	ConvexPolygon()
+	{
+	}
+
+public:
+/**
+  *\param Polygon polygon a convex polygon, e.g. the result of a hull algorithm
+  *
+  *\brief A constructor to prepare the polygon for queries.
+  */
+	ConvexPolygon(Polygon polygon)
+	{
+		int h = polygon.getSize();
+		vector<double> x(h), y(h);
+		for(int iter = 0; iter < h; iter++)
+		{
+			Point p = polygon.getPoint(iter);
+			x[iter] = p.x;
+			y[iter] = p.y;
+		}
+		vector<int> corners(h);
+		for(int iter = 0; iter < h; iter++)
+			corners[iter] = iter;
+		prepare(PointSetView(x.data(), y.data(), NULL, h), corners);
+	}
+
+public:
+/**
+  *\param PointSetView points
+  *\param const vector<int> &hull the indices of the corners of a convex polygon, e.g. the result of a hull algorithm
+  *
+  *\brief A constructor to prepare a hull given by indices, without making a Polygon.
+  */
+	ConvexPolygon(PointSetView points, const vector<int> &hull)
+	{
+		prepare(points, hull);
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return the number of corners after repeated corners and corners in the middle of an edge were removed
+  */
+	int getSize(void) const
+	{
+		return px.size();
+	}
+
+public:
+/**
+  *\fn Location locate(double x, double y) const
+  *\return where the point (x, y) is
+  *
+  *\brief A function to classify a point in O(logh) time.
+  */
+	Location locate(double x, double y) const
+	{
+		int result;
+		locateScalar(*this, &x, &y, 1, &result);
+		return (Location)result;
+	}
+
+public:
+/**
+  *\fn Location locate(Point p) const
+  *\return where p is, its z co-ordinate is ignored
+  */
+	Location locate(Point p) const
+	{
+		return locate(p.x, p.y);
+	}
+
+public:
+/**
+  *\fn bool contains(Point p) const
+  *\return true if p is inside the polygon or on its boundary
+  */
+	bool contains(Point p) const
+	{
+		return locate(p.x, p.y) != OUTSIDE;
+	}
+
+public:
+/**
+  *\fn int extreme(double x, double y) const
+  *\param double x, y a direction
+  *\return the position in the polygon or the hull of a corner farthest in the direction, -1 if the polygon is empty
+  *
+  *\brief A function to get the corner with the largest x * px + y * py in O(logh) time, i.e. the support point of the polygon.
+  *
+  *The corner is the end of the edges whose angle is not after that of the direction turned by 90 degrees anticlockwise.
+  */
+	int extreme(double x, double y) const
+	{
+		int h = px.size();
+		if(h == 0)
+			return -1;
+		if(h < 3)
+			return original[h == 2 && x * dx[0] + y * dy[0] > 0 ? 1 : 0];
+		int low = 0;
+		for(int length = h + 1; length > 1; )
+		{
+			int half = length / 2, middle = low + half;
+			low += notAfter(dx[middle - 1], dy[middle - 1], -y, x) ? half : 0;
+			length -= half;
+		}
+		return original[low % h];
+	}
+
+public:
+/**
+  *\fn int extreme(Point direction) const
+  *\return the position of a corner farthest in the direction, the z co-ordinate is ignored
+  */
+	int extreme(Point direction) const
+	{
+		return extreme(direction.x, direction.y);
+	}
+
+public:
+/**
+  *\fn bool tangents(double x, double y, int &left, int &right) const
+  *\param double x, y a point
+  *\param int &left the corner of the tangent which has all the corners on its right, as seen from the point
+  *\param int &right the corner of the tangent which has all the corners on its left
+  *\return false and both corners -1 if the point is not outside the polygon
+  *
+  *\brief A function to get the two tangents from a point in O(logh) time, as positions in the polygon or the hull.
+  *
+  *The edges which the point sees form a chain from left to right.
+  *If several corners are on a tangent, the one nearest to the point is returned.
+  */
+	bool tangents(double x, double y, int &left, int &right) const
+	{
+		int h = px.size();
+		left = right = -1;
+		if(h < 3)
+			return smallTangents(x, y, left, right);
+		int lowerFirst, lowerLast, upperFirst, upperLast, first, last;
+		bool lower = seenEdges(0, rightmost, 1, x, y, lowerFirst, lowerLast);
+		bool upper = seenEdges(rightmost, h, -1, x, y, upperFirst, upperLast);
+		if(!lower && !upper)
+			return false;
+		if(!upper || (lower && lowerLast == rightmost - 1 && upperFirst == rightmost))
+			first = lowerFirst;
+		else
+			first = upperFirst;
+		if(!lower || (upper && lowerLast == rightmost - 1 && upperFirst == rightmost))
+			last = upperLast;
+		else
+			last = lowerLast;
+		left = original[first];
+		right = original[(last + 1) % h];
+		return true;
+	}
+
+public:
+/**
+  *\fn bool tangents(Point p, int &left, int &right) const
+  *\return false if p is not outside the polygon, its z co-ordinate is ignored
+  */
+	bool tangents(Point p, int &left, int &right) const
+	{
+		return tangents(p.x, p.y, left, right);
+	}
+
+public:
+/**
+  *\fn void locateBatch(PointSetView points, int *out, int threads) const
+  *\param PointSetView points
+  *\param int *out the Location of every point
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to classify many points at once.
+  */
+	void locateBatch(PointSetView points, int *out, int threads = 1) const
+	{
+		forEachBlock(points.size, threads, [&](int begin, int end) {
+			kernels().locate(*this, points.x + begin, points.y + begin, end - begin, out + begin);
+		});
+	}
+
+public:
+/**
+  *\fn void extremeBatch(PointSetView directions, int *out, int threads) const
+  *\param PointSetView directions the x and y of every direction
+  *\param int *out the position of a corner farthest in every direction
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to get the support points of many directions at once.
+  */
+	void extremeBatch(PointSetView directions, int *out, int threads = 1) const
+	{
+		forEachBlock(directions.size, threads, [&](int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+				out[iter] = extreme(directions.x[iter], directions.y[iter]);
+		});
+	}
+
+public:
+/**
+  *\fn void tangentBatch(PointSetView points, int *left, int *right, int threads) const
+  *\param PointSetView points
+  *\param int *left, *right the corners of the tangents from every point, -1 for the points which are not outside
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to get the tangents from many points at once.
+  */
+	void tangentBatch(PointSetView points, int *left, int *right, int threads = 1) const
+	{
+		forEachBlock(points.size, threads, [&](int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+				tangents(points.x[iter], points.y[iter], left[iter], right[iter]);
+		});
+	}
+
+public:
+/**
+  *\fn static Orientation::Kernel getKernel(void)
+  *\return the kernel used by the batch function
+  */
+	static Orientation::Kernel getKernel(void)
+	{
+		return kernels().kernel;
+	}
+
+public:
+/**
+  *\fn static bool setKernel(Orientation::Kernel kernel)
+  *\return false if the kernel is not supported on this machine
+  *
+  *\brief Force a version of the batch function, mostly for testing and benchmarking.
+  *
+  *It is not safe to call it while other threads use the batch function.
+  */
+	static bool setKernel(Orientation::Kernel kernel)
+	{
+		if(!Orientation::isSupported(kernel))
+			return false;
+		kernels() = makeTable(kernel);
+		return true;
+	}
+
+/**
+  *\var vector<double> px, py
+  *\brief The corners, anticlockwise.
+  *
+  *\var vector<double> ex, ey
+  *\brief The corners minus the first corner, the sides of the fan.
+  *
+  *\var vector<double> dx, dy
+  *\brief The edges, from every corner to the next one.
+  *
+  *\var vector<int> original
+  *\brief The position of every corner in the polygon or the hull it was prepared from.
+  *
+  *\var int rightmost
+  *\brief The corner with the largest x and then the largest y, the end of the lower chain.
+  */
+private:
+	vector<double> px, py, ex, ey, dx, dy;
+	vector<int> original;
+	int rightmost = 0;
+
+/**
+  *\var static const int MIN_QUERIES
+  *\brief The number of points in a task of the batch function.
+  */
+private:
+	static const int MIN_QUERIES = 1 << 14;
+
+/**
+  *\fn void prepare(PointSetView points, const vector<int> &hull)
+  *
+  *\brief Copy the corners, drop the corners which do not turn and make the order anticlockwise from the leftmost corner.
+  *
+  *Repeated corners are dropped first, then a corner is dropped if it is on the line through its neighbours.
+  *If all the corners are on a line, the polygon is the segment between the least and the largest of them, or a single point.
+  */
+private:
+	void prepare(PointSetView points, const vector<int> &hull)
+	{
+		int h = hull.size();
+		const double *x = points.x, *y = points.y;
+		vector<int> distinct;						//positions of the corners without the repeated ones
+		for(int iter = 0; iter < h; iter++)
+		{
+			int a = distinct.empty() ? -1 : hull[distinct.back()], b = hull[iter];
+			if(a < 0 || x[a] != x[b] || y[a] != y[b])
+				distinct.push_back(iter);
+		}
+		while(distinct.size() > 1 && x[hull[distinct.back()]] == x[hull[distinct[0]]] && y[hull[distinct.back()]] == y[hull[distinct[0]]])
+			distinct.pop_back();
+		int k = distinct.size();
+		for(int iter = 0; iter < k; iter++)
+		{
+			int a = hull[distinct[(iter + k - 1) % k]], b = hull[distinct[iter]], c = hull[distinct[(iter + 1) % k]];
+			if(turn(x[a], y[a], x[b], y[b], x[c], y[c]) != 0)
+				original.push_back(distinct[iter]);
+		}
+		if(original.size() < 3)
+		{
+			original.clear();
+			int least = 0, largest = 0;
+			for(int iter = 1; iter < h; iter++)
+			{
+				int a = hull[least], b = hull[largest], c = hull[iter];
+				if(x[c] < x[a] || (x[c] == x[a] && y[c] < y[a]))
+					least = iter;
+				if(x[c] > x[b] || (x[c] == x[b] && y[c] > y[b]))
+					largest = iter;
+			}
+			if(h > 0)
+				original.push_back(least);
+			if(h > 0 && (x[hull[least]] != x[hull[largest]] || y[hull[least]] != y[hull[largest]]))
+				original.push_back(largest);
+		}
+
+		double area = 0;
+		int n = original.size();
+		for(int iter = 1; iter + 1 < n; iter++)
+		{
+			int a = hull[original[0]], b = hull[original[iter]], c = hull[original[iter + 1]];
+			area += turn(x[a], y[a], x[b], y[b], x[c], y[c]);
+		}
+		if(area < 0)
+			reverse(original.begin() + 1, original.end());
+		int leftmost = 0;
+		for(int iter = 1; iter < n; iter++)
+		{
+			int a = hull[original[leftmost]], c = hull[original[iter]];
+			if(x[c] < x[a] || (x[c] == x[a] && y[c] < y[a]))
+				leftmost = iter;
+		}
+		rotate(original.begin(), original.begin() + leftmost, original.end());
+		for(int iter = 0; iter < n; iter++)
+		{
+			px.push_back(x[hull[original[iter]]]);
+			py.push_back(y[hull[original[iter]]]);
+			if(px[iter] > px[rightmost] || (px[iter] == px[rightmost] && py[iter] > py[rightmost]))
+				rightmost = iter;
+		}
+		for(int iter = 0; iter < n; iter++)
+		{
+			ex.push_back(px[iter] - px[0]);
+			ey.push_back(py[iter] - py[0]);
+			dx.push_back(px[(iter + 1) % n] - px[iter]);
+			dy.push_back(py[(iter + 1) % n] - py[iter]);
+		}
+	}
+
+/**
+  *\fn static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+  *\return twice the signed area of the triangle abc, positive if c is on the left of a to b
+  */
+private:
+	static double turn(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+	}
+
+/**
+  *\fn static Location small(const ConvexPolygon &polygon, double x, double y)
+  *\return the Location of (x, y) for a polygon of less than 3 corners, i.e. a segment, a point or nothing
+  */
+private:
+	static Location small(const ConvexPolygon &polygon, double x, double y)
+	{
+		const vector<double> &px = polygon.px, &py = polygon.py;
+		if(px.empty())
+			return OUTSIDE;
+		if(px.size() == 1)
+			return x == px[0] && y == py[0] ? BOUNDARY : OUTSIDE;
+		bool between = (x - px[0]) * polygon.dx[0] + (y - py[0]) * polygon.dy[0] >= 0 && (x - px[1]) * polygon.dx[0] + (y - py[1]) * polygon.dy[0] <= 0;
+		return between && turn(px[0], py[0], px[1], py[1], x, y) == 0 ? BOUNDARY : OUTSIDE;
+	}
+
+/**
+  *\fn static Location classify(bool first, bool last, double wedgeFirst, double wedgeLast, double edge)
+  *\param bool first, last true if the triangle of the point is the first or the last one of the fan
+  *\param double wedgeFirst the turn of p0, p[1] and the point
+  *\param double wedgeLast the turn of p0, p[h - 1] and the point
+  *\param double edge the turn of p[i], p[i + 1] and the point
+  *
+  *\brief The point is on the boundary if it is on the edge of its triangle, or on the first or last side of the fan.
+  */
+private:
+	static Location classify(bool first, bool last, double wedgeFirst, double wedgeLast, double edge)
+	{
+		if(wedgeFirst < 0 || wedgeLast > 0 || edge < 0)
+			return OUTSIDE;
+		if(edge == 0 || (first && wedgeFirst == 0) || (last && wedgeLast == 0))
+			return BOUNDARY;
+		return INSIDE;
+	}
+
+/**
+  *\fn static bool notAfter(double ax, double ay, double bx, double by)
+  *\return true if the angle of a is not after the angle of b, both measured anticlockwise from the direction straight down
+  *
+  *The angles from just after straight down to straight up are in the first half, so the order in a half is given by a turn.
+  */
+private:
+	static bool notAfter(double ax, double ay, double bx, double by)
+	{
+		int first = ax > 0 || (ax == 0 && ay > 0) ? 0 : 1, second = bx > 0 || (bx == 0 && by > 0) ? 0 : 1;
+		return first < second || (first == second && ax * by - ay * bx >= 0);
+	}
+
+/**
+  *\fn bool seen(int edge, double x, double y) const
+  *\return true if the point (x, y) is strictly on the outer side of the edge
+  */
+private:
+	bool seen(int edge, double x, double y) const
+	{
+		return dx[edge] * (y - py[edge]) - dy[edge] * (x - px[edge]) < 0;
+	}
+
+/**
+  *\fn bool seenEdges(int first, int last, double sign, double x, double y, int &from, int &to) const
+  *\param int first, last the chain from corner first to corner last, where corner h is corner 0
+  *\param double sign 1 for the lower chain and -1 for the upper one, which is a lower chain when turned by 180 degrees
+  *\param int &from, &to the first and the last edge of the chain seen from (x, y)
+  *\return false if the point sees no edge of the chain
+  *
+  *\brief The lines of the edges of a lower chain are below it, and the one of the edge above the point is the highest at the x of the point.
+  *
+  *So if the point sees any edge, it sees the edge above it, or the first or the last edge if it is not above the chain.
+  *The edges it sees are the ones around that edge and they are found by two binary searches.
+  *Only the last edge of a chain may be vertical, and it is seen only if the point is after the end of the chain.
+  */
+private:
+	bool seenEdges(int first, int last, double sign, double x, double y, int &from, int &to) const
+	{
+		int h = px.size(), edge = first;
+		if(sign * x > sign * px[last % h])
+			edge = last - 1;
+		else
+		{
+			for(int length = last - first; length > 1; )
+			{
+				int half = length / 2, middle = edge + half;
+				edge += sign * px[middle] < sign * x ? half : 0;
+				length -= half;
+			}
+		}
+		if(!seen(edge, x, y))
+			return false;
+		int low = 0;
+		for(int length = edge - first + 1; length > 1; )
+		{
+			int half = length / 2, middle = low + half;
+			low += seen(first + middle - 1, x, y) ? 0 : half;
+			length -= half;
+		}
+		from = first + low;
+		low = edge;
+		for(int length = last - edge; length > 1; )
+		{
+			int half = length / 2, middle = low + half;
+			low += seen(middle, x, y) ? half : 0;
+			length -= half;
+		}
+		to = low;
+		return true;
+	}
+
+/**
+  *\fn bool smallTangents(double x, double y, int &left, int &right) const
+  *\return the tangents from (x, y) to a polygon of less than 3 corners, like tangents
+  */
+private:
+	bool smallTangents(double x, double y, int &left, int &right) const
+	{
+		if(small(*this, x, y) != OUTSIDE)
+			return false;
+		if(px.size() == 1)
+		{
+			left = right = original[0];
+			return true;
+		}
+		double side = turn(x, y, px[0], py[0], px[1], py[1]);
+		bool nearer = (x - px[0]) * dx[0] + (y - py[0]) * dy[0] < 0;			//if the point is on the line, the nearer end
+		left = original[side < 0 || (side == 0 && nearer) ? 0 : 1];
+		right = original[side > 0 || (side == 0 && nearer) ? 0 : 1];
+		return true;
+	}
+
+/**
+  *\fn template<class Call> void forEachBlock(int m, int threads, Call call) const
+  *
+  *\brief Split the queries into blocks and call call(begin, end) for each of them on a pool, or all at once without one.
+  */
+private:
+	template<class Call>
+	void forEachBlock(int m, int threads, Call call) const
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || m < 2 * MIN_QUERIES)
+		{
+			if(m > 0)
+				call(0, m);
+			return;
+		}
+		WorkStealingPool pool(threads);
+		WorkStealingPool::Group group;
+		for(int begin = 0; begin < m; begin += MIN_QUERIES)
+		{
+			int end = min(m, begin + MIN_QUERIES);
+			pool.run(group, [&call, begin, end]() { call(begin, end); });
+		}
+		pool.wait(group);
+	}
+
+/**
+  *\var struct Table
+  *\brief The batch function currently used, picked once at the first call.
+  */
+private:
+	struct Table
+	{
+		Orientation::Kernel kernel;
+		void (*locate)(const ConvexPolygon &, const double *, const double *, int, int *);
+	};
+
+private:
+	static Table &kernels(void)
+	{
+		static Table table = detect();
+		return table;
+	}
+
+private:
+	static Table detect(void)
+	{
+		if(Orientation::isSupported(Orientation::AVX2))
+			return makeTable(Orientation::AVX2);
+		return makeTable(Orientation::SCALAR);
+	}
+
+private:
+	static Table makeTable(Orientation::Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		if(kernel == Orientation::AVX2)
+			return {Orientation::AVX2, locateAVX2};
+#endif
+		return {Orientation::SCALAR, locateScalar};
+	}
+
+/**
+  *\fn static void locateScalar(const ConvexPolygon &polygon, const double *x, const double *y, int m, int *out)
+  *
+  *\brief The binary search finds the largest i from 1 to h - 1 with p[i] not on the right of the point as seen from p0,
+  *halving the length of the range at every step whatever the result, and then i is limited to h - 2.
+  */
+private:
+	static void locateScalar(const ConvexPolygon &polygon, const double *x, const double *y, int m, int *out)
+	{
+		int h = polygon.px.size();
+		if(h < 3)
+		{
+			for(int iter = 0; iter < m; iter++)
+				out[iter] = small(polygon, x[iter], y[iter]);
+			return;
+		}
+		const double *ex = polygon.ex.data(), *ey = polygon.ey.data();
+		double ox = polygon.px[0], oy = polygon.py[0];
+		for(int iter = 0; iter < m; iter++)
+		{
+			double tx = x[iter] - ox, ty = y[iter] - oy;
+			double wedgeFirst = ex[1] * ty - ey[1] * tx, wedgeLast = ex[h - 1] * ty - ey[h - 1] * tx;
+			int low = 1;
+			for(int length = h - 1; length > 1; )
+			{
+				int half = length / 2, middle = low + half;
+				low += ex[middle] * ty - ey[middle] * tx >= 0 ? half : 0;
+				length -= half;
+			}
+			int i = min(low, h - 2);
+			double edge = polygon.dx[i] * (y[iter] - polygon.py[i]) - polygon.dy[i] * (x[iter] - polygon.px[i]);
+			out[iter] = classify(i == 1, i == h - 2, wedgeFirst, wedgeLast, edge);
+		}
+	}
+
+#ifdef CGEO_X86_SIMD
+/**
+  *\fn static __m256d gather(const double *base, __m128i index)
+  *\return the four doubles at the four positions of index
+  */
+private:
+	__attribute__((target("avx2")))
+	static __m256d gather(const double *base, __m128i index)
+	{
+		__m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, index, all, 8);
+	}
+
+/**
+  *The AVX2 version, eight points at a time in two groups of four, so that the gathers of the two groups overlap.
+  *The corners of every step are read with gathers and the masks of the compares are narrowed to 32 bits to add to the positions.
+  */
+private:
+	__attribute__((target("avx2")))
+	static void locateAVX2(const ConvexPolygon &polygon, const double *x, const double *y, int m, int *out)
+	{
+		int h = polygon.px.size();
+		if(h < 3)
+		{
+			locateScalar(polygon, x, y, m, out);
+			return;
+		}
+		const double *ex = polygon.ex.data(), *ey = polygon.ey.data();
+		__m256d ox = _mm256_set1_pd(polygon.px[0]), oy = _mm256_set1_pd(polygon.py[0]), zero = _mm256_setzero_pd();
+		__m256d firstX = _mm256_set1_pd(ex[1]), firstY = _mm256_set1_pd(ey[1]), lastX = _mm256_set1_pd(ex[h - 1]), lastY = _mm256_set1_pd(ey[h - 1]);
+		__m256i narrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+		int i = 0;
+		for(; i + 8 <= m; i += 8)
+		{
+			__m256d qx[2], qy[2], tx[2], ty[2];
+			__m128i low[2];
+			for(int half = 0; half < 2; half++)
+			{
+				qx[half] = _mm256_loadu_pd(x + i + 4 * half);
+				qy[half] = _mm256_loadu_pd(y + i + 4 * half);
+				tx[half] = _mm256_sub_pd(qx[half], ox);
+				ty[half] = _mm256_sub_pd(qy[half], oy);
+				low[half] = _mm_set1_epi32(1);
+			}
+			for(int length = h - 1; length > 1; )
+			{
+				int step = length / 2;
+				for(int half = 0; half < 2; half++)
+				{
+					__m128i middle = _mm_add_epi32(low[half], _mm_set1_epi32(step));
+					__m256d cx = gather(ex, middle), cy = gather(ey, middle);
+					__m256d side = _mm256_cmp_pd(_mm256_sub_pd(_mm256_mul_pd(cx, ty[half]), _mm256_mul_pd(cy, tx[half])), zero, _CMP_GE_OQ);
+					__m128i mask = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(side), narrow));
+					low[half] = _mm_add_epi32(low[half], _mm_and_si128(mask, _mm_set1_epi32(step)));
+				}
+				length -= step;
+			}
+			for(int half = 0; half < 2; half++)
+			{
+				__m256d wedgeFirst = _mm256_sub_pd(_mm256_mul_pd(firstX, ty[half]), _mm256_mul_pd(firstY, tx[half]));
+				__m256d wedgeLast = _mm256_sub_pd(_mm256_mul_pd(lastX, ty[half]), _mm256_mul_pd(lastY, tx[half]));
+				__m128i index = _mm_min_epi32(low[half], _mm_set1_epi32(h - 2));
+				__m256d cx = gather(polygon.px.data(), index), cy = gather(polygon.py.data(), index);
+				__m256d ux = gather(polygon.dx.data(), index), uy = gather(polygon.dy.data(), index);
+				__m256d edge = _mm256_sub_pd(_mm256_mul_pd(ux, _mm256_sub_pd(qy[half], cy)), _mm256_mul_pd(uy, _mm256_sub_pd(qx[half], cx)));
+				double first[4], last[4], edges[4];
+				int positions[4];
+				_mm256_storeu_pd(first, wedgeFirst);
+				_mm256_storeu_pd(last, wedgeLast);
+				_mm256_storeu_pd(edges, edge);
+				_mm_storeu_si128((__m128i *)positions, index);
+				for(int lane = 0; lane < 4; lane++)
+					out[i + 4 * half + lane] = classify(positions[lane] == 1, positions[lane] == h - 2, first[lane], last[lane], edges[lane]);
+			}
+		}
+		locateScalar(polygon, x + i, y + i, m - i, out + i);
+	}
+#endif
+};
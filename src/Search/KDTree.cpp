@@ -0,0 +1,647 @@
+/**\file: KDTree.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A static k-d tree of points in 2 or 3 dimensions for nearest neighbour and radius queries.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The tree is built once from all the points. Every node splits its points at the median of the co-ordinate with the largest spread,
+  *till a node has at most a bucket of points, which makes it a leaf.
+  *The nodes are kept in one array and refer to their children by position, and the co-ordinates are copied in the order of the leaves,
+  *so the points of a leaf are contiguous and a leaf is scanned like an array.
+  *The squared distances of the points of a leaf are computed with a scalar, an SSE2 or an AVX2 kernel, picked like in Orientation.
+  *All versions evaluate the same expression, so they give exactly the same results.
+  *A query goes first to the side of every split which contains it, and to the other side only if the cell of that side is closer than
+  *the farthest of the neighbours found so far, or the split is closer than the radius.
+  *The batch functions sort the queries along a Z-order curve, so that consecutive queries visit the same leaves,
+  *and split them between the threads of a WorkStealingPool.
+  *Building takes O(nlogn) time and O(n) memory.
+  */
+class KDTree
+{
+public:
+/**
+  *\brief A constructor for an empty tree.
+  */
+	KDTree()
+	{
+		dimension = 2;
+	}
+
+public:
+/**
+  *\param PointSetView points
+  *\param int bucket the most points in a leaf, from 1 to 256
+  *
+  *\brief A constructor to build the tree of the points, in 3 dimensions if the view has z co-ordinates.
+  *
+  *The co-ordinates are copied, the queries give the indices of the points in points.
+  */
+	KDTree(PointSetView points, int bucket = 32)
+	{
+		build(points, max(1, min(bucket, MAX_BUCKET)));
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return the number of points
+  */
+	int getSize(void) const
+	{
+		return ids.size();
+	}
+
+public:
+/**
+  *\fn int getDimension(void) const
+  *\return 2 or 3
+  */
+	int getDimension(void) const
+	{
+		return dimension;
+	}
+
+public:
+/**
+  *\fn int nearest(Point query, int k, int *indices, double *distances) const
+  *\param Point query
+  *\param int k
+  *\param int *indices an array for the indices of the k points nearest to query
+  *\param double *distances an array for their distances, or NULL
+  *\return the number of points found, k or the number of points if there are less
+  *
+  *\brief A function to get the k nearest neighbours of a point, the nearest first.
+  *
+  *Points at the same distance are ordered by their indices. The z co-ordinate of query is ignored in 2 dimensions.
+  */
+	int nearest(Point query, int k, int *indices, double *distances) const
+	{
+		k = max(0, min(k, getSize()));
+		vector<pair<double, int> > heap(k);
+		Search search = {query.x, query.y, query.z, k, 0, heap.data()};
+		return finish(search, indices, distances);
+	}
+
+public:
+/**
+  *\fn vector<int> nearest(Point query, int k) const
+  *\return the indices of the k points nearest to query, the nearest first
+  */
+	vector<int> nearest(Point query, int k) const
+	{
+		vector<int> result(max(0, min(k, getSize())));
+		nearest(query, k, result.data(), NULL);
+		return result;
+	}
+
+public:
+/**
+  *\fn void radiusQuery(Point query, double radius, vector<int> &out) const
+  *\param vector<int> &out the indices of the points at distance at most radius from query are added at its end
+  *
+  *\brief A function to get the points in a ball, in no particular order.
+  */
+	void radiusQuery(Point query, double radius, vector<int> &out) const
+	{
+		if(!nodes.empty() && radius >= 0)
+			radiusSearch(0, query.x, query.y, query.z, radius * radius, out);
+	}
+
+public:
+/**
+  *\fn vector<int> radiusQuery(Point query, double radius) const
+  *\return the indices of the points at distance at most radius from query
+  */
+	vector<int> radiusQuery(Point query, double radius) const
+	{
+		vector<int> result;
+		radiusQuery(query, radius, result);
+		return result;
+	}
+
+public:
+/**
+  *\fn void nearestBatch(PointSetView queries, int k, vector<int> &indices, vector<double> &distances, int threads) const
+  *\param PointSetView queries
+  *\param int k
+  *\param vector<int> &indices the neighbours of query i are indices[i * k] to indices[i * k + k - 1]
+  *\param vector<double> &distances their distances, in the same places
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to get the k nearest neighbours of many points at once.
+  *
+  *k is reduced to the number of points of the tree if there are less.
+  */
+	void nearestBatch(PointSetView queries, int k, vector<int> &indices, vector<double> &distances, int threads = 1) const
+	{
+		int m = queries.size;
+		k = max(0, min(k, getSize()));
+		indices.resize((size_t)m * k);
+		distances.resize((size_t)m * k);
+		vector<int> order = localOrder(queries);
+		forEachBlock(m, threads, [&](int begin, int end) {
+			vector<pair<double, int> > heap(k);
+			for(int iter = begin; iter < end; iter++)
+			{
+				int q = order[iter];
+				Search search = {queries.x[q], queries.y[q], queries.z ? queries.z[q] : 0.0, k, 0, heap.data()};
+				finish(search, indices.data() + (size_t)q * k, distances.data() + (size_t)q * k);
+			}
+		});
+	}
+
+public:
+/**
+  *\fn void radiusBatch(PointSetView queries, double radius, vector<int> &result, vector<int> &offsets, int threads) const
+  *\param vector<int> &result the indices of the points of all the balls, one ball after the other
+  *\param vector<int> &offsets the points of ball i are result[offsets[i]] to result[offsets[i + 1] - 1]
+  *
+  *\brief A function to get the points in many balls of the same radius at once, stored like the hulls of BatchHull.
+  */
+	void radiusBatch(PointSetView queries, double radius, vector<int> &result, vector<int> &offsets, int threads = 1) const
+	{
+		int m = queries.size;
+		vector<int> order = localOrder(queries);
+		vector<vector<int> > found(m);
+		forEachBlock(m, threads, [&](int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				int q = order[iter];
+				radiusQuery(Point(queries.x[q], queries.y[q], queries.z ? queries.z[q] : 0.0), radius, found[q]);
+			}
+		});
+		offsets.assign(m + 1, 0);
+		for(int iter = 0; iter < m; iter++)
+			offsets[iter + 1] = offsets[iter] + found[iter].size();
+		result.resize(offsets[m]);
+		for(int iter = 0; iter < m; iter++)
+			copy(found[iter].begin(), found[iter].end(), result.begin() + offsets[iter]);
+	}
+
+public:
+/**
+  *\fn static Orientation::Kernel getKernel(void)
+  *\return the kernel used to scan the leaves
+  */
+	static Orientation::Kernel getKernel(void)
+	{
+		return kernels().kernel;
+	}
+
+public:
+/**
+  *\fn static bool setKernel(Orientation::Kernel kernel)
+  *\return false if the kernel is not supported on this machine
+  *
+  *\brief Force a version of the leaf scan, mostly for testing and benchmarking.
+  *
+  *It is not safe to call it while other threads search.
+  */
+	static bool setKernel(Orientation::Kernel kernel)
+	{
+		if(!Orientation::isSupported(kernel))
+			return false;
+		kernels() = makeTable(kernel);
+		return true;
+	}
+
+/**
+  *\var struct Node
+  *\brief A node of the tree.
+  *
+  *An inner node splits at split along axis 0, 1 or 2, its children are the nodes first and second.
+  *A leaf has axis -1 and its points are first to second - 1 of the copied co-ordinates.
+  */
+private:
+	struct Node
+	{
+		double split;
+		int axis, first, second;
+	};
+
+/**
+  *\var vector<Node> nodes
+  *\brief The nodes, the root first.
+  *
+  *\var vector<double> xs, ys, zs
+  *\brief The co-ordinates in the order of the leaves, zs is empty in 2 dimensions.
+  *
+  *\var vector<int> ids
+  *\brief The index of every point in the view the tree was built from.
+  *
+  *\var double low[3], high[3]
+  *\brief The bounding box of the points, used to sort the queries of the batch functions.
+  */
+	vector<Node> nodes;
+	vector<double> xs, ys, zs;
+	vector<int> ids;
+	int dimension;
+	double low[3], high[3];
+
+/**
+  *\var static const int MAX_BUCKET
+  *\brief The largest bucket, the squared distances of a leaf are kept in an array of this size on the stack.
+  *
+  *\var static const int MIN_QUERIES
+  *\brief The number of queries in a task of the batch functions.
+  */
+private:
+	static const int MAX_BUCKET = 256;
+	static const int MIN_QUERIES = 1 << 10;
+
+/**
+  *\fn void build(PointSetView points, int bucket)
+  *
+  *\brief Split the indices recursively, then copy the co-ordinates in the order of the indices.
+  */
+private:
+	void build(PointSetView points, int bucket)
+	{
+		int n = points.size;
+		dimension = points.z ? 3 : 2;
+		ids.resize(n);
+		for(int iter = 0; iter < n; iter++)
+			ids[iter] = iter;
+		const double *axes[3] = {points.x, points.y, points.z};
+		for(int axis = 0; axis < 3; axis++)
+		{
+			low[axis] = high[axis] = 0;
+			if(axis < dimension && n > 0)
+			{
+				low[axis] = *min_element(axes[axis], axes[axis] + n);
+				high[axis] = *max_element(axes[axis], axes[axis] + n);
+			}
+		}
+		nodes.clear();
+		if(n > 0)
+			split(axes, 0, n, bucket);
+
+		xs.resize(n);
+		ys.resize(n);
+		zs.resize(dimension == 3 ? n : 0);
+		for(int iter = 0; iter < n; iter++)
+		{
+			xs[iter] = points.x[ids[iter]];
+			ys[iter] = points.y[ids[iter]];
+			if(dimension == 3)
+				zs[iter] = points.z[ids[iter]];
+		}
+	}
+
+/**
+  *\fn int split(const double **axes, int begin, int end, int bucket)
+  *\return the position of the node of the points begin to end - 1
+  *
+  *\brief Put the median of the axis with the largest spread in the middle with nth_element and split there.
+  */
+	int split(const double **axes, int begin, int end, int bucket)
+	{
+		int index = nodes.size();
+		nodes.push_back(Node());
+		if(end - begin <= bucket)
+		{
+			nodes[index].axis = -1;
+			nodes[index].first = begin;
+			nodes[index].second = end;
+			nodes[index].split = 0;
+			return index;
+		}
+		int axis = 0;
+		double spread = -1;
+		for(int a = 0; a < dimension; a++)
+		{
+			double least = INFINITY, largest = -INFINITY;
+			for(int iter = begin; iter < end; iter++)
+			{
+				least = min(least, axes[a][ids[iter]]);
+				largest = max(largest, axes[a][ids[iter]]);
+			}
+			if(largest - least > spread)
+			{
+				spread = largest - least;
+				axis = a;
+			}
+		}
+		const double *values = axes[axis];
+		int middle = begin + (end - begin) / 2;
+		nth_element(ids.begin() + begin, ids.begin() + middle, ids.begin() + end, [values](int A, int B) {
+			return values[A] < values[B];
+		});
+		nodes[index].axis = axis;
+		nodes[index].split = values[ids[middle]];
+		int left = split(axes, begin, middle, bucket);
+		int right = split(axes, middle, end, bucket);
+		nodes[index].first = left;
+		nodes[index].second = right;
+		return index;
+	}
+
+/**
+  *\var struct Search
+  *\brief A k nearest neighbour query and its neighbours so far, kept as a max heap of size at most k.
+  *
+  *The heap has the squared distance and the index of every neighbour, compared as pairs so the ties are broken by the index.
+  */
+private:
+	struct Search
+	{
+		double x, y, z;
+		int k, size;
+		pair<double, int> *heap;
+	};
+
+/**
+  *\fn int finish(Search &search, int *indices, double *distances) const
+  *
+  *\brief Run the search and write the neighbours, the nearest first, with their distances if distances is not NULL.
+  */
+private:
+	int finish(Search &search, int *indices, double *distances) const
+	{
+		double offsets[3] = {0, 0, 0};
+		if(search.k > 0)
+			nearestSearch(0, search, 0, offsets);
+		int count = search.size;
+		pair<double, int> *found = search.heap;
+		sort(found, found + count);
+		for(int iter = 0; iter < count; iter++)
+		{
+			indices[iter] = found[iter].second;
+			if(distances)
+				distances[iter] = sqrt(found[iter].first);
+		}
+		return count;
+	}
+
+/**
+  *\fn void nearestSearch(int node, Search &search, double bound, double *offsets) const
+  *\param double bound the squared distance from the query to the cell of node
+  *\param double *offsets the distance from the query to the cell along every axis, zero if the query is inside along it
+  *
+  *\brief Scan a leaf, or search the near child and then the far child if its cell is closer than the farthest neighbour.
+  *
+  *The distance to the cell of the far child differs from bound only along the axis of the split, so it is updated in O(1).
+  */
+private:
+	void nearestSearch(int node, Search &search, double bound, double *offsets) const
+	{
+		const Node &current = nodes[node];
+		if(current.axis < 0)
+		{
+			double squared[MAX_BUCKET];
+			int begin = current.first, count = current.second - current.first;
+			kernels().distances(xs.data() + begin, ys.data() + begin, zs.empty() ? NULL : zs.data() + begin, count, search.x, search.y, search.z, squared);
+			for(int iter = 0; iter < count; iter++)
+				if(search.size < search.k || make_pair(squared[iter], ids[begin + iter]) < search.heap[0])
+					push(search, make_pair(squared[iter], ids[begin + iter]));
+			return;
+		}
+		int axis = current.axis;
+		double difference = (axis == 0 ? search.x : axis == 1 ? search.y : search.z) - current.split;
+		nearestSearch(difference < 0 ? current.first : current.second, search, bound, offsets);
+		double old = offsets[axis];
+		bound += difference * difference - old * old;
+		if(search.size < search.k || bound <= search.heap[0].first)	//a point at the same distance may have a smaller index
+		{
+			offsets[axis] = difference;
+			nearestSearch(difference < 0 ? current.second : current.first, search, bound, offsets);
+			offsets[axis] = old;
+		}
+	}
+
+/**
+  *\fn static void push(Search &search, pair<double, int> neighbour)
+  *
+  *\brief Add a point to the heap, removing the farthest one, with the largest index among the farthest, if the heap is full.
+  */
+private:
+	static void push(Search &search, pair<double, int> neighbour)
+	{
+		pair<double, int> *heap = search.heap;
+		int at;
+		if(search.size < search.k)
+		{
+			at = search.size++;
+			while(at > 0 && heap[(at - 1) / 2] < neighbour)		//sift up
+			{
+				heap[at] = heap[(at - 1) / 2];
+				at = (at - 1) / 2;
+			}
+		}
+		else
+		{
+			at = 0;
+			while(true)											//sift down from the root
+			{
+				int child = 2 * at + 1;
+				if(child >= search.size)
+					break;
+				if(child + 1 < search.size && heap[child + 1] > heap[child])
+					child++;
+				if(heap[child] <= neighbour)
+					break;
+				heap[at] = heap[child];
+				at = child;
+			}
+		}
+		heap[at] = neighbour;
+	}
+
+/**
+  *\fn void radiusSearch(int node, double x, double y, double z, double squaredRadius, vector<int> &out) const
+  */
+private:
+	void radiusSearch(int node, double x, double y, double z, double squaredRadius, vector<int> &out) const
+	{
+		const Node &current = nodes[node];
+		if(current.axis < 0)
+		{
+			double squared[MAX_BUCKET];
+			int begin = current.first, count = current.second - current.first;
+			kernels().distances(xs.data() + begin, ys.data() + begin, zs.empty() ? NULL : zs.data() + begin, count, x, y, z, squared);
+			for(int iter = 0; iter < count; iter++)
+				if(squared[iter] <= squaredRadius)
+					out.push_back(ids[begin + iter]);
+			return;
+		}
+		double difference = (current.axis == 0 ? x : current.axis == 1 ? y : z) - current.split;
+		if(difference <= 0 || difference * difference <= squaredRadius)
+			radiusSearch(current.first, x, y, z, squaredRadius, out);
+		if(difference >= 0 || difference * difference <= squaredRadius)
+			radiusSearch(current.second, x, y, z, squaredRadius, out);
+	}
+
+/**
+  *\fn vector<int> localOrder(PointSetView queries) const
+  *\return the indices of the queries sorted along a Z-order curve over the bounding box of the tree
+  *
+  *Every co-ordinate is scaled to 26 bits in 2 dimensions or 17 bits in 3 dimensions and the bits are interleaved,
+  *which fits in the 53 bits of a double, so the queries can be sorted with RadixSort::sortBy.
+  */
+private:
+	vector<int> localOrder(PointSetView queries) const
+	{
+		int m = queries.size, bits = dimension == 3 ? 17 : 26;
+		const double *axes[3] = {queries.x, queries.y, queries.z};
+		vector<double> keys(m);
+		for(int q = 0; q < m; q++)
+		{
+			uint64_t key = 0;
+			for(int axis = 0; axis < dimension; axis++)
+			{
+				double value = axes[axis] ? axes[axis][q] : 0.0, range = high[axis] - low[axis];
+				double scaled = range > 0 ? (value - low[axis]) / range : 0.0;
+				uint64_t cell = (uint64_t)(max(0.0, min(1.0, scaled)) * ((1 << bits) - 1));
+				for(int bit = 0; bit < bits; bit++)
+					key |= ((cell >> bit) & 1) << (bit * dimension + axis);
+			}
+			keys[q] = key;
+		}
+		vector<int> order(m);
+		for(int q = 0; q < m; q++)
+			order[q] = q;
+		RadixSort::sortBy(keys.data(), order);
+		return order;
+	}
+
+/**
+  *\fn template<class Call> void forEachBlock(int m, int threads, Call call) const
+  *
+  *\brief Split the queries into blocks and call call(begin, end) for each of them on a pool, or all at once without one.
+  */
+private:
+	template<class Call>
+	void forEachBlock(int m, int threads, Call call) const
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || m < 2 * MIN_QUERIES)
+		{
+			if(m > 0)
+				call(0, m);
+			return;
+		}
+		WorkStealingPool pool(threads);
+		WorkStealingPool::Group group;
+		for(int begin = 0; begin < m; begin += MIN_QUERIES)
+		{
+			int end = min(m, begin + MIN_QUERIES);
+			pool.run(group, [&call, begin, end]() { call(begin, end); });
+		}
+		pool.wait(group);
+	}
+
+/**
+  *\var struct Table
+  *\brief The leaf scan currently used, picked once at the first call.
+  */
+private:
+	struct Table
+	{
+		Orientation::Kernel kernel;
+		void (*distances)(const double *, const double *, const double *, int, double, double, double, double *);
+	};
+
+private:
+	static Table &kernels(void)
+	{
+		static Table table = detect();
+		return table;
+	}
+
+private:
+	static Table detect(void)
+	{
+		if(Orientation::isSupported(Orientation::AVX2))
+			return makeTable(Orientation::AVX2);
+		if(Orientation::isSupported(Orientation::SSE2))
+			return makeTable(Orientation::SSE2);
+		return makeTable(Orientation::SCALAR);
+	}
+
+private:
+	static Table makeTable(Orientation::Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		if(kernel == Orientation::AVX2)
+			return {Orientation::AVX2, distancesAVX2};
+		if(kernel == Orientation::SSE2)
+			return {Orientation::SSE2, distancesSSE2};
+#endif
+		return {Orientation::SCALAR, distancesScalar};
+	}
+
+/**
+  *\fn static void distancesScalar(const double *x, const double *y, const double *z, int n, double qx, double qy, double qz, double *out)
+  *\param const double *z NULL in 2 dimensions
+  *
+  *\brief The squared distances of n points to (qx, qy, qz), evaluated as (dx * dx + dy * dy) + dz * dz.
+  */
+private:
+	static void distancesScalar(const double *x, const double *y, const double *z, int n, double qx, double qy, double qz, double *out)
+	{
+		for(int i = 0; i < n; i++)
+		{
+			double dx = x[i] - qx, dy = y[i] - qy;
+			out[i] = dx * dx + dy * dy;
+			if(z)
+			{
+				double dz = z[i] - qz;
+				out[i] += dz * dz;
+			}
+		}
+	}
+
+#ifdef CGEO_X86_SIMD
+/**
+  *SSE2 and AVX2 versions of the leaf scan, two and four points at a time.
+  */
+private:
+	__attribute__((target("sse2")))
+	static void distancesSSE2(const double *x, const double *y, const double *z, int n, double qx, double qy, double qz, double *out)
+	{
+		__m128d px = _mm_set1_pd(qx), py = _mm_set1_pd(qy), pz = _mm_set1_pd(qz);
+		int i = 0;
+		for(; i + 2 <= n; i += 2)
+		{
+			__m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), px), dy = _mm_sub_pd(_mm_loadu_pd(y + i), py);
+			__m128d squared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+			if(z)
+			{
+				__m128d dz = _mm_sub_pd(_mm_loadu_pd(z + i), pz);
+				squared = _mm_add_pd(squared, _mm_mul_pd(dz, dz));
+			}
+			_mm_storeu_pd(out + i, squared);
+		}
+		distancesScalar(x + i, y + i, z ? z + i : NULL, n - i, qx, qy, qz, out + i);
+	}
+
+private:
+	__attribute__((target("avx2")))
+	static void distancesAVX2(const double *x, const double *y, const double *z, int n, double qx, double qy, double qz, double *out)
+	{
+		__m256d px = _mm256_set1_pd(qx), py = _mm256_set1_pd(qy), pz = _mm256_set1_pd(qz);
+		int i = 0;
+		for(; i + 4 <= n; i += 4)
+		{
+			__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), px), dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), py);
+			__m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+			if(z)
+			{
+				__m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + i), pz);
+				squared = _mm256_add_pd(squared, _mm256_mul_pd(dz, dz));
+			}
+			_mm256_storeu_pd(out + i, squared);
+		}
+		distancesScalar(x + i, y + i, z ? z + i : NULL, n - i, qx, qy, qz, out + i);
+	}
+#endif
+};
+
+/**
+  *\brief The definition of MAX_BUCKET, which is passed by reference to min, so it needs one when the calls are not optimised away.
+  */
+const int KDTree::MAX_BUCKET;
@@ -0,0 +1,485 @@
+/**\file: OneDSearch.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A static index of numbers, e.g. the x co-ordinates of a set of points, for 1D range queries.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The keys are sorted once and laid out as an implicit B+ tree in a flat array, 8 keys to a node so that a node is one cache line.
+  *The lowest layer is the sorted keys themselves, and every layer above has a key for every child but the first one of a node,
+  *the least key under that child. The children of node k are the nodes k * 9 to k * 9 + 8 of the layer below,
+  *so there are no pointers and the tree has about log9(n) layers, the upper ones small enough to stay in the cache.
+  *A node is searched without branches by counting its keys smaller than the query, with AVX2 two compares do it for the whole node.
+  *The count in the lowest layer gives the position of the answer in the sorted order directly.
+  *The fastest version supported by the processor is picked when the program starts, like Orientation.
+  *The batch functions search a group of queries in lockstep, prefetching the next node of every query,
+  *so the cache misses of different queries overlap.
+  *A range query returns the positions of its first and last key in the sorted order, so it needs no memory,
+  *and the indices of the points in the range are a slice of getOrder().
+  *Building takes O(nlogn) time, a query O(logn) time.
+  *NaN keys are not supported.
+  */
+class OneDSearch
+{
+/**
+  *\class Range
+  *\brief The indices of the points of a range query, in the order of their keys.
+  *
+  *It points into the index, so it can be used in a range based for loop till the index is destroyed.
+  */
+public:
+	class Range
+	{
+	public:
+		const int *first, *last;
+
+		Range(const int *first, const int *last) : first(first), last(last)
+		{
+		}
+
+		const int *begin(void) const
+		{
+			return first;
+		}
+
+		const int *end(void) const
+		{
+			return last;
+		}
+
+		int size(void) const
+		{
+			return last - first;
+		}
+	};
+
+public:
+/**
+  *\brief A constructor for an empty index.
+  */
+	OneDSearch()
+	{
+		layers.assign(1, 0);
+	}
+
+public:
+/**
+  *\param PointSetView points
+  *
+  *\brief A constructor to index the points by their x co-ordinates.
+  */
+	OneDSearch(PointSetView points)
+	{
+		build(points.x, points.size);
+	}
+
+public:
+/**
+  *\param const double *values
+  *\param int n
+  *
+  *\brief A constructor to index n numbers, the index of a number is its position in values.
+  */
+	OneDSearch(const double *values, int n)
+	{
+		build(values, n);
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return the number of keys
+  */
+	int getSize(void) const
+	{
+		return order.size();
+	}
+
+public:
+/**
+  *\fn const vector<int> &getOrder(void) const
+  *\return the indices of the keys sorted by their keys, equal keys in the order of their indices
+  */
+	const vector<int> &getOrder(void) const
+	{
+		return order;
+	}
+
+public:
+/**
+  *\fn int lowerBound(double value) const
+  *\return the position in getOrder() of the first key which is not less than value, getSize() if there is none
+  */
+	int lowerBound(double value) const
+	{
+		int result;
+		bounds(&value, 1, false, &result);
+		return result;
+	}
+
+public:
+/**
+  *\fn int upperBound(double value) const
+  *\return the position in getOrder() of the first key which is greater than value, getSize() if there is none
+  */
+	int upperBound(double value) const
+	{
+		int result;
+		bounds(&value, 1, true, &result);
+		return result;
+	}
+
+public:
+/**
+  *\fn Range searchQuery(double low, double high) const
+  *\param double low
+  *\param double high
+  *\return the indices of the keys from low to high, both included
+  *
+  *\brief A function to get the points in a range without copying them.
+  */
+	Range searchQuery(double low, double high) const
+	{
+		int first = lowerBound(low), last = max(first, upperBound(high));
+		return Range(order.data() + first, order.data() + last);
+	}
+
+public:
+/**
+  *\fn Range searchQuery(Point A, Point B) const
+  *\return the indices of the points with x from A.x to B.x
+  */
+	Range searchQuery(Point A, Point B) const
+	{
+		return searchQuery(A.x, B.x);
+	}
+
+public:
+/**
+  *\fn int count(double low, double high) const
+  *\return the number of keys from low to high, both included
+  */
+	int count(double low, double high) const
+	{
+		return max(0, upperBound(high) - lowerBound(low));
+	}
+
+public:
+/**
+  *\fn void searchBatch(const double *low, const double *high, int m, int *first, int *last, int threads) const
+  *\param const double *low, *high the m ranges
+  *\param int *first, *last the positions in getOrder() of every range are first[i] to last[i] - 1
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to answer many range queries at once, much faster than one at a time for a large index.
+  */
+	void searchBatch(const double *low, const double *high, int m, int *first, int *last, int threads = 1) const
+	{
+		forEachBlock(m, threads, [&](int begin, int end) {
+			bounds(low + begin, end - begin, false, first + begin);
+			bounds(high + begin, end - begin, true, last + begin);
+			for(int iter = begin; iter < end; iter++)
+				last[iter] = max(first[iter], last[iter]);
+		});
+	}
+
+public:
+/**
+  *\fn void countBatch(const double *low, const double *high, int m, int *out, int threads) const
+  *\param int *out the number of keys in every range
+  *
+  *\brief The same as searchBatch, giving only the number of keys in every range.
+  */
+	void countBatch(const double *low, const double *high, int m, int *out, int threads = 1) const
+	{
+		forEachBlock(m, threads, [&](int begin, int end) {
+			vector<int> first(end - begin);
+			bounds(low + begin, end - begin, false, first.data());
+			bounds(high + begin, end - begin, true, out + begin);
+			for(int iter = begin; iter < end; iter++)
+				out[iter] = max(0, out[iter] - first[iter - begin]);
+		});
+	}
+
+public:
+/**
+  *\fn static Orientation::Kernel getKernel(void)
+  *\return the kernel used by the searches
+  */
+	static Orientation::Kernel getKernel(void)
+	{
+		return kernels().kernel;
+	}
+
+public:
+/**
+  *\fn static bool setKernel(Orientation::Kernel kernel)
+  *\return false if the kernel is not supported on this machine
+  *
+  *\brief Force a version of the node search, mostly for testing and benchmarking.
+  *
+  *It is not safe to call it while other threads search.
+  */
+	static bool setKernel(Orientation::Kernel kernel)
+	{
+		if(!Orientation::isSupported(kernel))
+			return false;
+		kernels() = makeTable(kernel);
+		return true;
+	}
+
+/**
+  *\var static const int B
+  *\brief The number of keys in a node, 8 doubles fill a cache line of 64 bytes.
+  *
+  *\var static const int GROUP
+  *\brief The number of queries searched in lockstep by the batch functions.
+  */
+private:
+	static const int B = 8;
+	static const int GROUP = 64;
+
+/**
+  *\var struct Node
+  *\brief A node of the tree, aligned to a cache line with c++17, unused keys are +infinity.
+  */
+private:
+	struct alignas(64) Node
+	{
+		double keys[B];
+	};
+
+/**
+  *\var vector<Node> tree
+  *\brief The nodes of all the layers, the lowest layer first.
+  *
+  *\var vector<int> layers
+  *\brief The first node of every layer, and the number of nodes at the end.
+  *
+  *\var vector<int> order
+  *\brief The indices of the keys in sorted order.
+  */
+	vector<Node> tree;
+	vector<int> layers;
+	vector<int> order;
+
+/**
+  *\fn void build(const double *values, int n)
+  *
+  *\brief Sort the indices by their keys, copy the keys to the lowest layer and build the layers above it.
+  *
+  *Key j of node k of a layer is the least key under child k * 9 + j + 1, the first key of its leftmost node in the lowest layer.
+  */
+private:
+	void build(const double *values, int n)
+	{
+		order.resize(n);
+		for(int iter = 0; iter < n; iter++)
+			order[iter] = iter;
+		RadixSort::sortBy(values, order);
+
+		layers.assign(1, 0);
+		for(int nodes = (n + B - 1) / B; nodes > 0; nodes = nodes > 1 ? (nodes + B) / (B + 1) : 0)
+			layers.push_back(layers.back() + nodes);
+		Node empty;
+		fill(empty.keys, empty.keys + B, INFINITY);
+		tree.assign(layers.back(), empty);
+		for(int iter = 0; iter < n; iter++)
+			tree[iter / B].keys[iter % B] = values[order[iter]];
+		for(int h = 1; h + 1 < (int)layers.size(); h++)
+			for(int k = 0; k < layers[h + 1] - layers[h]; k++)
+				for(int j = 0; j < B; j++)
+				{
+					long long first = (long long)k * (B + 1) + j + 1;
+					for(int l = 1; l < h && first < n; l++)
+						first *= B + 1;
+					if(first * B < n)
+						tree[layers[h] + k].keys[j] = tree[first].keys[0];
+				}
+	}
+
+/**
+  *\fn template<class Call> void forEachBlock(int m, int threads, Call call) const
+  *
+  *\brief Split the queries into blocks and call call(begin, end) for each of them on a pool, or all at once without one.
+  */
+private:
+	template<class Call>
+	void forEachBlock(int m, int threads, Call call) const
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || m < 2 * MIN_TASK)
+		{
+			if(m > 0)
+				call(0, m);
+			return;
+		}
+		WorkStealingPool pool(threads);
+		WorkStealingPool::Group group;
+		for(int begin = 0; begin < m; begin += MIN_TASK)
+		{
+			int end = min(m, begin + MIN_TASK);
+			pool.run(group, [&call, begin, end]() { call(begin, end); });
+		}
+		pool.wait(group);
+	}
+
+/**
+  *\var static const int MIN_TASK
+  *\brief The number of queries in a task of the pool.
+  */
+private:
+	static const int MIN_TASK = 1 << 14;
+
+/**
+  *\var struct Table
+  *\brief The search currently used, picked once at the first call.
+  */
+private:
+	struct Table
+	{
+		Orientation::Kernel kernel;
+		void (*lower)(const OneDSearch &, const double *, int, int *);
+		void (*upper)(const OneDSearch &, const double *, int, int *);
+	};
+
+private:
+	static Table &kernels(void)
+	{
+		static Table table = detect();
+		return table;
+	}
+
+private:
+	static Table detect(void)
+	{
+		if(Orientation::isSupported(Orientation::AVX2))
+			return makeTable(Orientation::AVX2);
+		return makeTable(Orientation::SCALAR);
+	}
+
+private:
+	static Table makeTable(Orientation::Kernel kernel)
+	{
+#ifdef CGEO_X86_SIMD
+		if(kernel == Orientation::AVX2)
+			return {Orientation::AVX2, boundsAVX2<false>, boundsAVX2<true>};
+#endif
+		return {Orientation::SCALAR, boundsScalar<false>, boundsScalar<true>};
+	}
+
+/**
+  *\fn void bounds(const double *values, int m, bool upper, int *out) const
+  *\param bool upper false for the first key not less than every value, true for the first key greater than it
+  */
+private:
+	void bounds(const double *values, int m, bool upper, int *out) const
+	{
+		if(upper)
+			kernels().upper(*this, values, m, out);
+		else
+			kernels().lower(*this, values, m, out);
+	}
+
+/**
+  *\fn static void prefetch(const void *address)
+  *\brief Ask the processor to load a node which will be searched soon.
+  */
+private:
+	static void prefetch(const void *address)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#endif
+	}
+
+/**
+  *\fn template<bool UPPER> static void boundsScalar(const OneDSearch &index, const double *values, int m, int *out)
+  *
+  *\brief Search m values, GROUP of them in lockstep from the top layer to the lowest one.
+  *
+  *In every node the number i of keys less than x (not greater than x for UPPER) is counted and the search goes on in child i.
+  *In the lowest layer the count is added to the position of the node.
+  *For UPPER +infinity is searched as the largest double, so that the unused keys are never counted, and its answer is n.
+  */
+private:
+	template<bool UPPER>
+	static void boundsScalar(const OneDSearch &index, const double *values, int m, int *out)
+	{
+		const Node *tree = index.tree.data();
+		const int *layers = index.layers.data();
+		int top = index.layers.size() - 2, n = index.order.size();
+		for(int begin = 0; begin < m; begin += GROUP)
+		{
+			int g = min(GROUP, m - begin);
+			double x[GROUP];
+			int k[GROUP];
+			for(int j = 0; j < g; j++)
+			{
+				x[j] = UPPER ? min(values[begin + j], DBL_MAX) : values[begin + j];
+				k[j] = 0;
+			}
+			for(int h = top; h >= 0; h--)
+				for(int j = 0; j < g; j++)
+				{
+					const double *keys = tree[layers[h] + k[j]].keys;
+					int i = 0;
+					for(int t = 0; t < B; t++)
+						i += UPPER ? keys[t] <= x[j] : keys[t] < x[j];
+					k[j] = h > 0 ? k[j] * (B + 1) + i : k[j] * B + i;
+					if(h > 0)
+						prefetch(tree + layers[h - 1] + k[j]);
+				}
+			for(int j = 0; j < g; j++)
+				out[begin + j] = top < 0 || (UPPER && values[begin + j] == INFINITY) ? n : min(k[j], n);
+		}
+	}
+
+#ifdef CGEO_X86_SIMD
+/**
+  *The AVX2 version, the keys of a node are counted with two compares, a mask and a popcount.
+  */
+private:
+	template<bool UPPER>
+	__attribute__((target("avx2,popcnt")))
+	static void boundsAVX2(const OneDSearch &index, const double *values, int m, int *out)
+	{
+		const Node *tree = index.tree.data();
+		const int *layers = index.layers.data();
+		int top = index.layers.size() - 2, n = index.order.size();
+		for(int begin = 0; begin < m; begin += GROUP)
+		{
+			int g = min(GROUP, m - begin);
+			double x[GROUP];
+			int k[GROUP];
+			for(int j = 0; j < g; j++)
+			{
+				x[j] = UPPER ? min(values[begin + j], DBL_MAX) : values[begin + j];
+				k[j] = 0;
+			}
+			for(int h = top; h >= 0; h--)
+				for(int j = 0; j < g; j++)
+				{
+					const double *keys = tree[layers[h] + k[j]].keys;
+					__m256d value = _mm256_set1_pd(x[j]);
+					__m256d low = UPPER ? _mm256_cmp_pd(_mm256_loadu_pd(keys), value, _CMP_LE_OQ) : _mm256_cmp_pd(_mm256_loadu_pd(keys), value, _CMP_LT_OQ);
+					__m256d high = UPPER ? _mm256_cmp_pd(_mm256_loadu_pd(keys + 4), value, _CMP_LE_OQ) : _mm256_cmp_pd(_mm256_loadu_pd(keys + 4), value, _CMP_LT_OQ);
+					int i = __builtin_popcount(_mm256_movemask_pd(low) | _mm256_movemask_pd(high) << 4);
+					k[j] = h > 0 ? k[j] * (B + 1) + i : k[j] * B + i;
+					if(h > 0)
+						prefetch(tree + layers[h - 1] + k[j]);
+				}
+			for(int j = 0; j < g; j++)
+				out[begin + j] = top < 0 || (UPPER && values[begin + j] == INFINITY) ? n : min(k[j], n);
+		}
+	}
+#endif
+};
+
+/**
+  *\brief The definition of GROUP, which is passed by reference to min, so it needs one when the calls are not optimised away.
+  */
+const int OneDSearch::GROUP;
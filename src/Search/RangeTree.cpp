@@ -0,0 +1,516 @@
+/**\file: RangeTree.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: A static 2D range tree to count and report the points in axis parallel rectangles.
+  *
+  *\warning: compile it with c++11 or later version for best results
+  *\warning: It refers to some other files which are not referenced here. Use the CGeoExtension.cpp for compilation
+  *
+  *The points are sorted by x, and a balanced binary tree is built on their positions in that order,
+  *a node at level L covering 2^(H - L) consecutive positions, with H the number of levels below the root.
+  *Every node keeps its points sorted by y. All the lists of a level are stored one after the other in a flat array,
+  *the list of a node at the positions it covers, so the tree itself needs no pointers.
+  *The root list is searched once for the y range with a OneDSearch. Going down, the position of the range in a child list
+  *is the number of points before it that go to that child, which is kept for every position of a level.
+  *This is fractional cascading, every level takes O(1) time and a query takes O(logn + k) time for k reported points.
+  *
+  *There are two modes.
+  *CASCADING keeps, for every level, the counts as ints and the indices of the points of every list, 8 bytes per point per level.
+  *COMPACT keeps only one bit per point per level, whether it goes to the left child, with a count for every 64 bits.
+  *Counting takes the same O(logn) time, but reporting a point has to follow it down to the last level, O(logn) per point.
+  *It needs about 0.2 bytes per point per level.
+  *The levels are built from the root down, every level in parallel on a WorkStealingPool.
+  *The time complexity of building is O(nlogn) and the memory O(nlogn).
+  */
+class RangeTree
+{
+public:
+/**
+  *\var enum Mode
+  *\brief How the levels are stored, see the description of the file.
+  */
+	enum Mode { CASCADING, COMPACT };
+
+public:
+/**
+  *\brief A constructor for an empty tree.
+  */
+	RangeTree()
+	{
+		n = 0;
+		height = 0;
+		mode = CASCADING;
+	}
+
+public:
+/**
+  *\param PointSetView points
+  *\param Mode mode
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A constructor to build the tree of the points, the z co-ordinates are ignored.
+  *
+  *The points are not copied, the queries give their indices in points.
+  */
+	RangeTree(PointSetView points, Mode mode = CASCADING, int threads = 0)
+	{
+		this->mode = mode;
+		build(points, threads);
+	}
+
+public:
+/**
+  *\fn int getSize(void) const
+  *\return the number of points
+  */
+	int getSize(void) const
+	{
+		return n;
+	}
+
+public:
+/**
+  *\fn Mode getMode(void) const
+  *\return the mode of the tree
+  */
+	Mode getMode(void) const
+	{
+		return mode;
+	}
+
+public:
+/**
+  *\fn int count(Point A, Point B) const
+  *\param Point A the corner with the least co-ordinates
+  *\param Point B the corner with the largest co-ordinates
+  *\return the number of points with A.x <= x <= B.x and A.y <= y <= B.y
+  *
+  *\brief A function to count the points in a rectangle in O(logn) time.
+  */
+	int count(Point A, Point B) const
+	{
+		int bounds[4];
+		getBounds(A.x, A.y, B.x, B.y, bounds);
+		int result = 0;
+		decompose(bounds, [&result](int, int, int low, int high) {
+			result += high - low;
+		});
+		return result;
+	}
+
+public:
+/**
+  *\fn void searchQuery(Point A, Point B, vector<int> &out) const
+  *\param Point A the corner with the least co-ordinates
+  *\param Point B the corner with the largest co-ordinates
+  *\param vector<int> &out the indices of the points in the rectangle are added at its end
+  *
+  *\brief A function to report the points in a rectangle, in no particular order.
+  */
+	void searchQuery(Point A, Point B, vector<int> &out) const
+	{
+		int bounds[4];
+		getBounds(A.x, A.y, B.x, B.y, bounds);
+		report(bounds, out);
+	}
+
+public:
+/**
+  *\fn vector<int> searchQuery(Point A, Point B) const
+  *\return the indices of the points in the rectangle
+  */
+	vector<int> searchQuery(Point A, Point B) const
+	{
+		vector<int> result;
+		searchQuery(A, B, result);
+		return result;
+	}
+
+public:
+/**
+  *\fn void countBatch(const double *x1, const double *y1, const double *x2, const double *y2, int m, int *out, int threads) const
+  *\param const double *x1, *y1 the corners with the least co-ordinates of the m rectangles
+  *\param const double *x2, *y2 the corners with the largest co-ordinates
+  *\param int *out the number of points in every rectangle
+  *\param int threads zero or less means the number of hardware threads and one means no pool
+  *
+  *\brief A function to count the points in many rectangles at once.
+  *
+  *The ranges of x and y of all the rectangles are first searched together with OneDSearch::searchBatch.
+  */
+	void countBatch(const double *x1, const double *y1, const double *x2, const double *y2, int m, int *out, int threads = 1) const
+	{
+		vector<int> bounds(4 * (size_t)m);
+		getBoundsBatch(x1, y1, x2, y2, m, bounds.data(), threads);
+		forEachBlock(m, threads, [&](int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				int result = 0;
+				decompose(bounds.data() + 4 * (size_t)iter, [&result](int, int, int low, int high) {
+					result += high - low;
+				});
+				out[iter] = result;
+			}
+		});
+	}
+
+public:
+/**
+  *\fn void searchBatch(const double *x1, const double *y1, const double *x2, const double *y2, int m, vector<int> &result, vector<int> &offsets, int threads) const
+  *\param vector<int> &result the indices of the points of all the rectangles, one rectangle after the other
+  *\param vector<int> &offsets the points of rectangle i are result[offsets[i]] to result[offsets[i + 1] - 1]
+  *
+  *\brief A function to report the points in many rectangles at once, stored like the hulls of BatchHull.
+  */
+	void searchBatch(const double *x1, const double *y1, const double *x2, const double *y2, int m, vector<int> &result, vector<int> &offsets, int threads = 1) const
+	{
+		vector<int> bounds(4 * (size_t)m);
+		getBoundsBatch(x1, y1, x2, y2, m, bounds.data(), threads);
+		offsets.assign(m + 1, 0);
+		forEachBlock(m, threads, [&](int begin, int end) {
+			for(int iter = begin; iter < end; iter++)
+			{
+				int total = 0;
+				decompose(bounds.data() + 4 * (size_t)iter, [&total](int, int, int low, int high) {
+					total += high - low;
+				});
+				offsets[iter + 1] = total;
+			}
+		});
+		for(int iter = 0; iter < m; iter++)
+			offsets[iter + 1] += offsets[iter];
+		result.resize(offsets[m]);
+		forEachBlock(m, threads, [&](int begin, int end) {
+			vector<int> found;
+			for(int iter = begin; iter < end; iter++)
+			{
+				found.clear();
+				report(bounds.data() + 4 * (size_t)iter, found);
+				copy(found.begin(), found.end(), result.begin() + offsets[iter]);
+			}
+		});
+	}
+
+/**
+  *\var int n, height
+  *\brief The number of points and the number of levels below the root, 2^height >= n.
+  *
+  *\var OneDSearch byX
+  *\brief The x co-ordinates, its order is the position of every point in the tree.
+  *
+  *\var OneDSearch byY
+  *\brief The y co-ordinates of the positions, its order is the list of the root.
+  *
+  *\var vector<int> counts, items
+  *\brief CASCADING: counts[L * (n + 1) + i] is the number of points at positions before i of level L which go to a left child,
+  *and items[L * n + i] is the index of the point at position i of level L.
+  *
+  *\var vector<uint64_t> bits, vector<int> ranks
+  *\brief COMPACT: bit i of level L is set if the point at position i goes to a left child, ranks has the counts of every 64 bits.
+  */
+private:
+	int n, height;
+	Mode mode;
+	OneDSearch byX, byY;
+	vector<int> counts, items;
+	vector<uint64_t> bits;
+	vector<int> ranks;
+
+/**
+  *\fn int words(void) const
+  *\return the number of 64 bit words of a level of bits, one more so that the count of position n can be read
+  */
+private:
+	int words(void) const
+	{
+		return n / 64 + 1;
+	}
+
+/**
+  *\fn int toLeft(int level, int i) const
+  *\return the number of points at the positions before i of level which go to a left child
+  */
+private:
+	int toLeft(int level, int i) const
+	{
+		if(mode == CASCADING)
+			return counts[(size_t)level * (n + 1) + i];
+		size_t word = (size_t)level * words() + (i >> 6);
+		return ranks[word] + popcount(bits[word] & (((uint64_t)1 << (i & 63)) - 1));
+	}
+
+private:
+	static int popcount(uint64_t word)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_popcountll(word);
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (word * 0x0101010101010101ULL) >> 56;
+#endif
+	}
+
+/**
+  *\fn int pointAt(int level, int i) const
+  *\return the index of the point at position i of level
+  *
+  *\brief In COMPACT mode the point is followed down to the last level, where the position is its position in x order.
+  */
+private:
+	int pointAt(int level, int i) const
+	{
+		if(level < height && mode == CASCADING)
+			return items[(size_t)level * n + i];
+		for(; level < height; level++)
+		{
+			int half = 1 << (height - level - 1), start = i & ~(2 * half - 1);
+			int before = toLeft(level, i) - toLeft(level, start), left = toLeft(level, i + 1) - toLeft(level, i);
+			i = left ? start + before : start + half + (i - start) - before;
+		}
+		return byX.getOrder()[i];
+	}
+
+/**
+  *\fn void getBounds(double x1, double y1, double x2, double y2, int *bounds) const
+  *\param int *bounds the positions in x order and in the root list of the points in the ranges
+  */
+private:
+	void getBounds(double x1, double y1, double x2, double y2, int *bounds) const
+	{
+		bounds[0] = byX.lowerBound(x1);
+		bounds[1] = byX.upperBound(x2);
+		bounds[2] = byY.lowerBound(y1);
+		bounds[3] = byY.upperBound(y2);
+	}
+
+private:
+	void getBoundsBatch(const double *x1, const double *y1, const double *x2, const double *y2, int m, int *bounds, int threads) const
+	{
+		vector<int> first(m), last(m);
+		byX.searchBatch(x1, x2, m, first.data(), last.data(), threads);
+		for(int iter = 0; iter < m; iter++)
+		{
+			bounds[4 * (size_t)iter] = first[iter];
+			bounds[4 * (size_t)iter + 1] = last[iter];
+		}
+		byY.searchBatch(y1, y2, m, first.data(), last.data(), threads);
+		for(int iter = 0; iter < m; iter++)
+		{
+			bounds[4 * (size_t)iter + 2] = first[iter];
+			bounds[4 * (size_t)iter + 3] = last[iter];
+		}
+	}
+
+/**
+  *\fn template<class Visit> void decompose(const int *bounds, Visit visit) const
+  *
+  *\brief Find the nodes whose positions are all in the x range and call visit(level, start, low, high) for each of them,
+  *where low to high - 1 are the positions in its list of the points in the y range.
+  *
+  *At most two nodes are split on every level, so O(logn) nodes are visited.
+  */
+private:
+	template<class Visit>
+	void decompose(const int *bounds, Visit visit) const
+	{
+		if(n > 0 && bounds[0] < bounds[1] && bounds[2] < bounds[3])
+			decompose(0, 0, bounds[2], bounds[3], bounds[0], bounds[1], visit);
+	}
+
+	template<class Visit>
+	void decompose(int level, int start, int low, int high, int a, int b, Visit &visit) const
+	{
+		if(low >= high)
+			return;
+		int width = 1 << (height - level), end = min(n, start + width);
+		if(b <= start || end <= a)
+			return;
+		if(a <= start && end <= b)
+		{
+			visit(level, start, low, high);
+			return;
+		}
+		int before = toLeft(level, start);
+		int leftLow = toLeft(level, start + low) - before, leftHigh = toLeft(level, start + high) - before;
+		decompose(level + 1, start, leftLow, leftHigh, a, b, visit);
+		decompose(level + 1, start + width / 2, low - leftLow, high - leftHigh, a, b, visit);
+	}
+
+private:
+	void report(const int *bounds, vector<int> &out) const
+	{
+		decompose(bounds, [this, &out](int level, int start, int low, int high) {
+			for(int iter = low; iter < high; iter++)
+				out.push_back(pointAt(level, start + iter));
+		});
+	}
+
+/**
+  *\fn void build(PointSetView points, int threads)
+  *
+  *\brief Sort the points by x and by y, then split the lists level by level.
+  *
+  *A point at position i of level L is in the node starting at i with the lowest height - L bits cleared,
+  *and it goes to the left child if bit height - L - 1 of its position in x order is 0.
+  *The counts of a level are a prefix sum, computed in parts: every part counts its points,
+  *then every part adds up its counts from the total of the parts before it, and finally moves its points to the next level.
+  */
+private:
+	void build(PointSetView points, int threads)
+	{
+		n = points.size;
+		byX = OneDSearch(points.x, n);
+		const vector<int> &xorder = byX.getOrder();
+		vector<double> yByPosition(n);
+		for(int iter = 0; iter < n; iter++)
+			yByPosition[iter] = points.y[xorder[iter]];
+		byY = OneDSearch(yByPosition.data(), n);
+		for(height = 0; (1LL << height) < n; height++);
+
+		if(mode == CASCADING)
+		{
+			counts.assign((size_t)height * (n + 1), 0);
+			items.assign((size_t)height * n, 0);
+		}
+		else
+		{
+			bits.assign((size_t)height * words(), 0);
+			ranks.assign((size_t)height * words(), 0);
+		}
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		int parts = max(1, min(threads, n / MIN_TASK));
+		unique_ptr<WorkStealingPool> pool;
+		if(parts > 1)
+			pool.reset(new WorkStealingPool(threads));
+
+		vector<int> list(byY.getOrder()), next(n), prefix(n + 1), partCounts(parts + 1);
+		for(int level = 0; level < height; level++)
+		{
+			int half = 1 << (height - level - 1);
+			forEachPart(pool.get(), parts, [&](int part, int begin, int end) {
+				int total = 0;
+				for(int iter = begin; iter < end; iter++)
+					total += !(list[iter] & half);
+				partCounts[part + 1] = total;
+			});
+			for(int part = 0; part < parts; part++)
+				partCounts[part + 1] += partCounts[part];
+			forEachPart(pool.get(), parts, [&](int part, int begin, int end) {
+				int total = partCounts[part];
+				for(int iter = begin; iter < end; iter++)
+				{
+					prefix[iter] = total;
+					total += !(list[iter] & half);
+				}
+			});
+			prefix[n] = partCounts[parts];
+			forEachPart(pool.get(), parts, [&](int, int begin, int end) {
+				for(int iter = begin; iter < end; iter++)
+				{
+					int start = iter & ~(2 * half - 1), before = prefix[iter] - prefix[start];
+					next[list[iter] & half ? start + half + (iter - start) - before : start + before] = list[iter];
+				}
+				if(mode == CASCADING)
+				{
+					copy(prefix.begin() + begin, prefix.begin() + end, counts.begin() + (size_t)level * (n + 1) + begin);
+					for(int iter = begin; iter < end; iter++)
+						items[(size_t)level * n + iter] = xorder[list[iter]];
+				}
+				else
+					packLevel(level, begin, end, list, prefix);
+			});
+			if(mode == CASCADING)
+				counts[(size_t)level * (n + 1) + n] = prefix[n];
+			list.swap(next);
+		}
+	}
+
+/**
+  *\fn void packLevel(int level, int begin, int end, const vector<int> &list, const vector<int> &prefix)
+  *
+  *\brief Set the bits of the points of a level which go to a left child and keep the count before every word.
+  *
+  *Only the words starting at a position from begin to end - 1 are written, the part with end n also writes the last word,
+  *so the parts of a level can pack their words at the same time.
+  */
+private:
+	void packLevel(int level, int begin, int end, const vector<int> &list, const vector<int> &prefix)
+	{
+		int half = 1 << (height - level - 1);
+		uint64_t *word = bits.data() + (size_t)level * words();
+		int *rank = ranks.data() + (size_t)level * words();
+		int last = (end == n) ? words() : (end + 63) / 64;
+		for(int w = (begin + 63) / 64; w < last; w++)
+		{
+			rank[w] = prefix[min(n, 64 * w)];
+			for(int iter = 64 * w; iter < min(n, 64 * w + 64); iter++)
+				if(!(list[iter] & half))
+					word[w] |= (uint64_t)1 << (iter & 63);
+		}
+	}
+
+/**
+  *\fn template<class Call> void forEachPart(WorkStealingPool *pool, int parts, Call call) const
+  *
+  *\brief Split the n positions of a level into parts and call call(part, begin, end) for each of them on the pool.
+  */
+private:
+	template<class Call>
+	void forEachPart(WorkStealingPool *pool, int parts, Call call) const
+	{
+		if(pool == NULL)
+		{
+			call(0, 0, n);
+			return;
+		}
+		WorkStealingPool::Group group;
+		for(int part = 0; part < parts; part++)
+		{
+			int begin = (long long)n * part / parts, end = (long long)n * (part + 1) / parts;
+			pool->run(group, [&call, part, begin, end]() { call(part, begin, end); });
+		}
+		pool->wait(group);
+	}
+
+/**
+  *\fn template<class Call> void forEachBlock(int m, int threads, Call call) const
+  *
+  *\brief Split the queries into blocks and call call(begin, end) for each of them on a pool, or all at once without one.
+  */
+private:
+	template<class Call>
+	void forEachBlock(int m, int threads, Call call) const
+	{
+		if(threads <= 0)
+			threads = thread::hardware_concurrency();
+		if(threads <= 1 || m < 2 * MIN_QUERIES)
+		{
+			if(m > 0)
+				call(0, m);
+			return;
+		}
+		WorkStealingPool pool(threads);
+		WorkStealingPool::Group group;
+		for(int begin = 0; begin < m; begin += MIN_QUERIES)
+		{
+			int end = min(m, begin + MIN_QUERIES);
+			pool.run(group, [&call, begin, end]() { call(begin, end); });
+		}
+		pool.wait(group);
+	}
+
+/**
+  *\var static const int MIN_TASK
+  *\brief The least number of positions of a level in a part of the build.
+  *
+  *\var static const int MIN_QUERIES
+  *\brief The number of queries in a task of the batch functions.
+  */
+private:
+	static const int MIN_TASK = 1 << 16;
+	static const int MIN_QUERIES = 1 << 12;
+};
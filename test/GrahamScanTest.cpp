@@ -0,0 +1,138 @@
+/**\file: GrahamScanTest.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Regression test for the angles of Graham Scan on the point which gives the direction.
+  *
+  *\warning: compile it with c++11 or later version, e.g. g++ -fsanitize=address GrahamScanTest.cpp
+  *
+  *The rotation of PlanarToSpherical gave the rightmost point a theta of 360 instead of 0 for this input.
+  *It was sorted last instead of first, and the scan of Graham Scan ran off the front of its vector.
+  *The theta of the direction point is checked with every kernel, then the hull is compared with the one of QuickHull.
+  *Last the hulls of inputs with copies of points and with points on one ray from the mean are checked,
+  *with the angles and the pseudo angles and with both sorts, as only the farthest point of a ray may be on the hull.
+  *Returns 0 if all the checks pass.
+  */
+#include "..\CGeoExtension.cpp"
+#include <random>
+
+static vector<Point> makePoints(void)
+{
+	mt19937 generator(3);
+	vector<Point> points;
+	for(int iter = 0; iter < 200; iter++)
+	{
+		double y = generator() % 1000 / 3.0;		//y first, as in Point(generator() % 1000 / 7.0, generator() % 1000 / 3.0) with gcc
+		double x = generator() % 1000 / 7.0;
+		points.push_back(Point(x, y, 0.0));
+	}
+	return points;
+}
+
+/**
+  *The hull must turn the same way at every corner, except on the middle of a straight edge, and no point may be outside it.
+  */
+static bool isHull(vector<Point> &points, Polygon hull)
+{
+	int size = hull.getSize(), sign = 0;
+	if(size < 3)
+		return true;
+	for(int iter = 0; iter < size; iter++)
+	{
+		Point a = hull.getPoint(iter), b = hull.getPoint((iter + 1) % size), c = hull.getPoint((iter + 2) % size);
+		double turn = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if(turn == 0 && (b.x - a.x) * (c.x - b.x) + (b.y - a.y) * (c.y - b.y) <= 0)
+			return false;							//a spike or a copy of a point
+		if(turn != 0 && sign == 0)
+			sign = turn > 0 ? 1 : -1;
+		if(turn * sign < 0)
+			return false;
+	}
+	for(Point p : points)
+		for(int iter = 0; iter < size; iter++)
+		{
+			Point a = hull.getPoint(iter), b = hull.getPoint((iter + 1) % size);
+			if(((b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)) * sign < 0)
+				return false;
+		}
+	return true;
+}
+
+static bool sameCorners(Polygon first, Polygon second)
+{
+	first = MergeHull::mergeHulls(vector<Polygon>(1, first), 1);		//only the corners, clockwise from the least one
+	second = MergeHull::mergeHulls(vector<Polygon>(1, second), 1);
+	if(first.getSize() != second.getSize())
+		return false;
+	for(int iter = 0; iter < first.getSize(); iter++)
+		if(first.getPoint(iter).x != second.getPoint(iter).x || first.getPoint(iter).y != second.getPoint(iter).y)
+			return false;
+	return true;
+}
+
+int main(void)
+{
+	vector<Point> points = makePoints();
+	int failures = 0;
+
+	Point origin(0.0, 0.0, 0.0), right = points[0];
+	for(Point p : points)
+	{
+		origin.x += p.x;
+		origin.y += p.y;
+		if(p.x > right.x || (p.x == right.x && p.y > right.y))
+			right = p;
+	}
+	origin.x = origin.x / points.size();				//the same interior point as Graham Scan
+	origin.y = origin.y / points.size();
+	Line direction(origin.x, origin.y, 0.0, right.x, right.y, 0.0);
+	const Orientation::Kernel kernels[] = {Orientation::SCALAR, Orientation::SSE2, Orientation::AVX2};
+	for(Orientation::Kernel kernel : kernels)
+	{
+		if(!PlanarToSpherical::setKernel(kernel))
+			continue;
+		vector<SphericalPoint> polar = PlanarToSpherical::convert(points, origin, direction);
+		for(int iter = 0; iter < (int)points.size(); iter++)
+			if(points[iter].x == right.x && points[iter].y == right.y && polar[iter].theta != 0)
+			{
+				printf("kernel %d: theta of direction point = %g\n", (int)kernel, polar[iter].theta);
+				failures++;
+				break;
+			}
+	}
+
+	if(!sameCorners(GrahamScan::convexHullGraham(points), QuickHull::convexHullQuick(points, 1)))
+	{
+		printf("Graham Scan and QuickHull differ\n");
+		failures++;
+	}
+
+	//copies of points and points on one ray from the mean, with every way of sorting the angles
+	mt19937 generator(5);
+	vector<vector<Point>> inputs(1, {Point(0.0, 0.0, 0.0), Point(4.0, 0.0, 0.0), Point(4.0, 4.0, 0.0), Point(0.0, 4.0, 0.0),
+		Point(1.0, 1.0, 0.0), Point(4.0, 4.0, 0.0), Point(0.0, 0.0, 0.0)});
+	for(int trial = 0; trial < 200; trial++)
+	{
+		vector<Point> grid;
+		for(int iter = 4 + generator() % 40; iter > 0; iter--)
+			grid.push_back(Point(generator() % 6 * 1.0, generator() % 6 * 1.0, 0.0));
+		inputs.push_back(grid);
+	}
+	for(int trial = 0; trial < (int)inputs.size(); trial++)
+		for(int mode = 0; mode < 5; mode++)
+		{
+			HullOptions options;
+			options.pseudoAngle = mode % 2 == 1;
+			options.radixSort = mode >= 2 && mode < 4;
+			options.prefilter = mode == 4;
+			PointSet set(inputs[trial]);
+			if(!isHull(inputs[trial], GrahamScan::convexHullGraham(inputs[trial], options)) || !isHull(inputs[trial], GrahamScan::convexHullGraham(set.getView(), options)))
+			{
+				printf("input %d, pseudoAngle %d, radixSort %d, prefilter %d: not a hull\n", trial, options.pseudoAngle, options.radixSort, options.prefilter);
+				failures++;
+			}
+		}
+
+	printf("%d failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}
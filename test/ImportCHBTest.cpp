@@ -0,0 +1,70 @@
+/**\file: ImportCHBTest.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Checks that ImportCHB reads back a .chb file and rejects one with a corrupt index of the hull.
+  *
+  *\warning: compile it with c++11 or later version, e.g. g++ -fsanitize=address ImportCHBTest.cpp
+  *
+  *The hull of some points is written with ExportToCH::writeBinary and read again.
+  *Then the first index of the hull in the file is replaced by the number of points and by -1,
+  *and the file must not be opened, as getHull would give that index to the callers.
+  *Returns 0 if all the checks pass.
+  */
+#include "..\CGeoExtension.cpp"
+#include <random>
+
+static string readFile(string filepath)
+{
+	ifstream file(filepath, ios::binary);
+	return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+static void writeFile(string filepath, const string &data)
+{
+	ofstream file(filepath, ios::binary);
+	file.write(data.data(), data.size());
+}
+
+int main(void)
+{
+	mt19937 generator(6);
+	const string filepath = "import_test.chb";
+	int failures = 0;
+
+	vector<Point> points;
+	for(int iter = 0; iter < 500; iter++)
+		points.push_back(Point(generator() % 10000 / 7.0, generator() % 10000 / 3.0, generator() % 100 / 1.0));
+	PointSet set(points, true);
+	vector<int> hull = Andrew::convexHullAndrewIndices(set.getView());
+	ExportToCH::writeBinary(set.getView(), hull, filepath);
+	{
+		ImportCHB file(filepath);
+		if(!file.isOpen() || file.getHull() != hull || file.getPoints().size != (int)points.size())
+		{
+			printf("the written file is not read back\n");
+			failures++;
+		}
+	}
+
+	string data = readFile(filepath);
+	size_t first = 32 + points.size() * 8 * 3;		//the first index of the hull
+	const int32_t corrupt[] = {(int32_t)points.size(), -1};
+	for(int32_t index : corrupt)
+	{
+		string changed = data;
+		for(int iter = 0; iter < 4; iter++)
+			changed[first + iter] = (char)((uint32_t)index >> (8 * iter));
+		writeFile(filepath, changed);
+		ImportCHB file(filepath);
+		if(file.isOpen())
+		{
+			printf("a file with the index %d of %d points is opened\n", index, (int)points.size());
+			failures++;
+		}
+	}
+	remove(filepath.c_str());
+
+	printf("%d failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/**\file: PrefilterTest.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Checks that HullOptions::prefilter does not change the .ch files of Andrew's Algorithm and Graham Scan.
+  *
+  *\warning: compile it with c++11 or later version, e.g. g++ -O2 PrefilterTest.cpp
+  *
+  *The prefilter only drops points which can not be on the hull, so it must be a pure speedup.
+  *For every input the .ch file is written with and without it, also together with the radix sort for Andrew's Algorithm,
+  *and the files are compared byte for byte.
+  *The inputs are uniform points, points on a small grid with collinear columns, points on a circle,
+  *and 113 points on a grid in pairs around y = 4 with three of them on the line y = 4, so they are on one ray from the mean.
+  *Returns 0 if all the files are the same.
+  */
+#include "..\CGeoExtension.cpp"
+#include <random>
+
+static string readFile(string filepath)
+{
+	ifstream file(filepath, ios::binary);
+	return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+static vector<Point> makePoints(mt19937 &generator, int kind, int n)
+{
+	vector<Point> points;
+	for(int iter = 0; iter < n; iter++)
+	{
+		if(kind == 0)
+			points.push_back(Point(generator() % 1000000 / 997.0, generator() % 1000000 / 991.0, 0.0));
+		else if(kind == 1)
+			points.push_back(Point(iter % 17 + 0.5 * (iter % 5 == 0), iter / 17 % 13, 0.0));
+		else if(kind == 3)
+		{
+			if(iter < 3)
+				points.push_back(Point(iter * 2.0 + 1, 4.0, 0.0));	//on one ray from the mean, as the mean of y is 4
+			else
+			{
+				double x = generator() % 13, y = generator() % 5;
+				points.push_back(Point(x, 4 + y, 0.0));
+				if(++iter < n)
+					points.push_back(Point(12 - x, 4 - y, 0.0));
+			}
+		}
+		else
+		{
+			double angle = 2 * acos(-1.0) * (generator() % 100000) / 100000;
+			double radius = iter % 4 == 0 ? 1000.0 : generator() % 1000 / 1.0;
+			points.push_back(Point(radius * cos(angle), radius * sin(angle), 0.0));
+		}
+	}
+	return points;
+}
+
+int main(void)
+{
+	mt19937 generator(4);
+	const string plain = "prefilter_plain.ch", filtered = "prefilter_filtered.ch";
+	int failures = 0;
+	for(int trial = 0; trial < 80; trial++)
+	{
+		int kind = trial % 4;
+		vector<Point> points = makePoints(generator, kind, kind == 3 ? 113 : 4 + generator() % 3000);
+		HullOptions prefilter;
+		prefilter.prefilter = true;
+		HullOptions radix;
+		radix.radixSort = true;
+		HullOptions both = radix;
+		both.prefilter = true;
+
+		Andrew::convexHullAndrewToCH(points, plain);
+		Andrew::convexHullAndrewToCH(points, filtered, prefilter);
+		if(readFile(plain) != readFile(filtered))
+		{
+			printf("trial %d: Andrew's Algorithm differs with the prefilter\n", trial);
+			failures++;
+		}
+		Andrew::convexHullAndrewToCH(points, plain, radix);
+		Andrew::convexHullAndrewToCH(points, filtered, both);
+		if(readFile(plain) != readFile(filtered))
+		{
+			printf("trial %d: Andrew's Algorithm with the radix sort differs with the prefilter\n", trial);
+			failures++;
+		}
+		GrahamScan::convexHullGrahamToCH(points, plain);
+		GrahamScan::convexHullGrahamToCH(points, filtered, prefilter);
+		if(readFile(plain) != readFile(filtered))
+		{
+			printf("trial %d: Graham Scan differs with the prefilter\n", trial);
+			failures++;
+		}
+	}
+	remove(plain.c_str());
+	remove(filtered.c_str());
+
+	printf("%d failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}
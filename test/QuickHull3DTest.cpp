@@ -0,0 +1,111 @@
+/**\file: QuickHull3DTest.cpp
+  *\author: Parth Kundaliya
+  *\author: Gurleen Cheema
+  *
+  *\brief: Checks that the facets of QuickHull3D close up into a convex hull of all the points.
+  *
+  *\warning: compile it with c++11 or later version, e.g. g++ -O2 QuickHull3DTest.cpp
+  *
+  *Every directed edge has to be used by exactly one facet and its reverse by another one, and no point may be above a facet.
+  *The inputs are points in a cube, a grid with many points on one plane, and two circles with a point just above the upper one.
+  *The point above the circle sees all the facets of the upper face at once, which gives a horizon of thousands of edges,
+  *and the points under and around it are given to the new facets with the binary search of QuickHull3D.
+  *Last the circles have points at random angles and the point is only 0.001 above the upper one,
+  *so three neighbouring points of that circle are nearly on one line and the facets near the upper face are nearly on one plane.
+  *Returns 0 if all the hulls pass.
+  */
+#include "..\CGeoExtension.cpp"
+#include <random>
+#include <map>
+
+static int check(const vector<Point> &points, const vector<Facet> &facets)
+{
+	int failures = 0;
+	map<pair<int, int>, int> edges;
+	double scale = 0;
+	for(Point p : points)
+		scale = max(scale, max(fabs(p.x), max(fabs(p.y), fabs(p.z))));
+	for(Facet facet : facets)
+	{
+		int corner[3] = {facet.a, facet.b, facet.c};
+		for(int e = 0; e < 3; e++)
+			edges[make_pair(corner[e], corner[(e + 1) % 3])]++;
+		Point A = points[facet.a], B = points[facet.b], C = points[facet.c];
+		double ux = B.x - A.x, uy = B.y - A.y, uz = B.z - A.z, vx = C.x - A.x, vy = C.y - A.y, vz = C.z - A.z;
+		double nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+		double length = sqrt(nx * nx + ny * ny + nz * nz);
+		if(length == 0)
+			continue;
+		for(Point p : points)
+			if((nx * (p.x - A.x) + ny * (p.y - A.y) + nz * (p.z - A.z)) / length > scale * 1e-9)
+			{
+				failures++;
+				break;
+			}
+	}
+	for(pair<const pair<int, int>, int> &edge : edges)
+		if(edge.second != 1 || !edges.count(make_pair(edge.first.second, edge.first.first)))
+			failures++;
+	return failures;
+}
+
+int main(void)
+{
+	mt19937 generator(7);
+	uniform_real_distribution<double> unit(0, 1);
+	const double pi = acos(-1.0);
+	int failures = 0;
+
+	vector<Point> cube;
+	for(int iter = 0; iter < 5000; iter++)
+		cube.push_back(Point(unit(generator), unit(generator), unit(generator)));
+
+	vector<Point> grid;
+	for(int iter = 0; iter < 6 * 6 * 6; iter++)
+		grid.push_back(Point(iter % 6, iter / 6 % 6, iter / 36));
+
+	vector<Point> circles;
+	for(int iter = 0; iter < 2000; iter++)
+	{
+		circles.push_back(Point(cos(2 * pi * iter / 2000), sin(2 * pi * iter / 2000), 0.0));
+		circles.push_back(Point(cos(2 * pi * iter / 2000), sin(2 * pi * iter / 2000), 1.0));
+	}
+	const double h = 0.01;
+	circles.push_back(Point(0.0, 0.0, 1 + h));
+	for(int iter = 0; iter < 5000; iter++)
+	{
+		double r = 0.99 * sqrt(unit(generator)), angle = 2 * pi * unit(generator);
+		double z = (iter % 2 == 0) ? 1 + 0.9 * h * (1 - r) * unit(generator) : 1 + h * (1 - r + r * unit(generator));
+		circles.push_back(Point(r * cos(angle), r * sin(angle), z));		//under the cone to the point above and between it and the top
+	}
+
+	vector<vector<Point>> inputs = {cube, grid, circles};
+	vector<string> names = {"cube", "grid", "circles"};
+	for(int trial = 0; trial < 20; trial++)
+	{
+		vector<Point> random;					//the upper circle is nearly flat under the point above it
+		for(int iter = 0; iter < 2000; iter++)
+		{
+			double angle = 2 * pi * unit(generator);
+			random.push_back(Point(cos(angle), sin(angle), 0.0));
+			angle = 2 * pi * unit(generator);
+			random.push_back(Point(cos(angle), sin(angle), 1.0));
+		}
+		random.push_back(Point(0.0, 0.0, 1.001));
+		inputs.push_back(random);
+		names.push_back("random circles " + to_string(trial));
+	}
+	for(int iter = 0; iter < (int)inputs.size(); iter++)
+	{
+		vector<Facet> facets = QuickHull3D::convexHull3D(inputs[iter]);
+		int bad = check(inputs[iter], facets);
+		if(facets.empty() || bad)
+		{
+			printf("%s: %d bad of %d facets\n", names[iter].c_str(), bad, (int)facets.size());
+			failures++;
+		}
+	}
+
+	printf("%d failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}